@@ -0,0 +1,118 @@
+/**
+ * @file    ic_actigraphy.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming actigraphy from accelerometer samples
+ *
+ * Every axis is high-passed (gravity and slow drift removed), vector magnitude of the result gives
+ * movement intensity. Per epoch: proportional integration (PIM), zero crossings with deadband
+ * (ZCM), time above threshold (TAT) and peak, plus movement and wake flags. Wake is scored from
+ * weighted activity of the current and previous epochs, so it needs no future epochs and is
+ * available as soon as the epoch ends. State has fixed size, batches of decoded samples
+ * (@ref stream_decode_other) are processed in chunks.
+ */
+
+#ifndef IC_ACTIGRAPHY_H
+#define IC_ACTIGRAPHY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup ACTIGRAPHY Actigraphy
+ *
+ * @{
+ */
+
+#define ACTIGRAPHY_HISTORY      5     // epochs in wake score
+
+#define ACTIGRAPHY_MOVEMENT     0x01  // PIM of epoch above movement threshold
+#define ACTIGRAPHY_WAKE         0x02  // weighted activity of recent epochs above wake threshold
+
+/**
+ * @brief Engine configuration
+ */
+typedef struct{
+  float sample_rate;      /*!< accelerometer sample rate [Hz] */
+  float mg_per_lsb;       /*!< accelerometer sensitivity */
+  float highpass;         /*!< high-pass cut-off [Hz] */
+  float epoch;            /*!< epoch length [s] */
+  float threshold;        /*!< ZCM deadband and TAT threshold [mg] */
+  float movement_pim;     /*!< PIM which flags movement [mg*s] */
+  float wake_score;       /*!< weighted PIM which flags wake [mg*s] */
+}s_actigraphyConfig;
+
+/**
+ * @brief Epoch result
+ */
+typedef struct{
+  uint32_t index;         /*!< epoch number since init */
+  float pim;              /*!< integral of movement magnitude [mg*s] */
+  float peak;             /*!< maximal movement magnitude [mg] */
+  float tat;              /*!< time above threshold [s] */
+  uint16_t zc;            /*!< threshold crossings of all axes */
+  uint8_t flags;          /*!< ACTIGRAPHY_* flags */
+}s_actigraphyEpoch;
+
+/**
+ * @brief Engine state of one device
+ */
+typedef struct{
+  s_actigraphyConfig config;
+  float hp_alpha;
+  uint32_t epoch_samples;
+  bool started;
+  int16_t last[3];                    /*!< last raw sample of every axis */
+  float hp[3];                        /*!< high-pass outputs [LSB] */
+  int8_t side[3];                     /*!< last deadband side crossed (-1, 0, 1) */
+
+  uint32_t in_epoch;                  /*!< samples of current epoch */
+  float sum;
+  float peak;
+  uint32_t above;
+  uint16_t zc;
+  uint32_t index;
+  float history[ACTIGRAPHY_HISTORY];  /*!< PIM of recent epochs, newest first */
+}s_actigraphyState;
+
+/**
+ * @brief Default configuration: 0.25 Hz high-pass, 30 s epochs, 16 bit +/-2 g accelerometer
+ *
+ * @param[out]  config      configuration
+ * @param[in]   sample_rate accelerometer sample rate [Hz]
+ */
+void actigraphy_default_config(s_actigraphyConfig *config, float sample_rate);
+
+/**
+ * @brief Initialize engine.
+ *
+ * @return false if epoch is shorter than one sample or high-pass cut-off is out of range
+ */
+bool actigraphy_init(s_actigraphyState *state, const s_actigraphyConfig *config);
+
+/**
+ * @brief Process accelerometer samples.
+ *
+ * @param[in,out] state   engine state
+ * @param[in]     acc_x   x axis samples
+ * @param[in]     acc_y   y axis samples
+ * @param[in]     acc_z   z axis samples
+ * @param[in]     count   number of samples
+ * @param[out]    out     completed epochs; room for count/epoch_samples + 1 entries
+ *
+ * @return number of completed epochs
+ */
+size_t actigraphy_process(s_actigraphyState *state, const int16_t *acc_x, const int16_t *acc_y,
+    const int16_t *acc_z, size_t count, s_actigraphyEpoch *out);
+
+/** @} */ //End of ACTIGRAPHY
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_ACTIGRAPHY_H */
@@ -0,0 +1,145 @@
+/**
+ * @file    ic_alarm_scheduler.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Host side emergency alarm scheduler
+ *
+ * Keeps wake-up schedule of many masks on one thread. When alarm comes due, scheduler builds
+ * alarm_set frame (@ref alarm_set) and hands it to the application. Alarm may be escalated
+ * (ALARM_SOFT -> ALARM_MEDIUM -> ALARM_HARD) in fixed intervals. Cancelling an alarm which was
+ * already sent to the mask generates alarm_off frame (@ref alarm_off).
+ */
+
+#ifndef IC_ALARM_SCHEDULER_H
+#define IC_ALARM_SCHEDULER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_low_level_control.h"
+#include "ic_timer_wheel.h"
+
+/** @defgroup ALARM_SCHEDULER emergency alarm scheduler
+ *
+ * @{
+ */
+
+typedef struct s_alarmTimer s_alarmTimer;
+
+/**
+ * @brief Frame handler
+ *
+ * Called from @ref alarm_scheduler_advance and @ref alarm_scheduler_cancel with ready to send
+ * frame.
+ *
+ * @param[in] timer timer which generated the frame (use context field to find the mask)
+ * @param[in] frame 20 bytes frame
+ * @param[in] len   frame length
+ * @param[in] uuid  index of UUID array (@ref nuc_init) to which frame should be written
+ * @param[in] user  user data given in @ref alarm_scheduler_init
+ */
+typedef void (*f_alarmFrameHandler)(s_alarmTimer *timer, char *frame, size_t len, int uuid,
+    void *user);
+
+/**
+ * @brief Alarm timer
+ *
+ * One per mask, owned by application. Has to be initialized with @ref alarm_timer_init.
+ */
+struct s_alarmTimer{
+  s_twNode node;
+  e_alarmType type;         /*!< alarm type sent on next expiry */
+  uint32_t time_to_alarm;   /*!< alarm_set "time" parameter */
+  uint16_t timeout;         /*!< alarm_set "timeout" parameter */
+  uint32_t escalation;      /*!< ticks between escalation steps, 0 - no escalation */
+  bool set_on_device;       /*!< alarm_set frame has been emitted */
+  void *context;            /*!< application data, e.g. mask handle */
+};
+
+/**
+ * @brief Alarm scheduler instance
+ */
+typedef struct{
+  s_timerWheel wheel;
+  f_alarmFrameHandler handler;
+  void *user;
+  uint16_t frame_id;        /*!< id of next generated frame */
+}s_alarmScheduler;
+
+/**
+ * @brief Initialize scheduler
+ *
+ * @param[out]  sched     scheduler instance
+ * @param[in]   now       current tick
+ * @param[in]   handler   frame handler
+ * @param[in]   user      user data passed to handler
+ * @param[in]   first_id  command counter of first generated frame
+ */
+void alarm_scheduler_init(s_alarmScheduler *sched, uint64_t now, f_alarmFrameHandler handler,
+    void *user, uint16_t first_id);
+
+/**
+ * @brief Initialize alarm timer
+ *
+ * @param[out]  timer   timer instance
+ * @param[in]   context application data
+ */
+void alarm_timer_init(s_alarmTimer *timer, void *context);
+
+/**
+ * @brief Arm (or re-arm) alarm.
+ *
+ * @param[in,out] sched       scheduler instance
+ * @param[in,out] timer       timer instance
+ * @param[in]     at          tick in which alarm_set frame will be generated
+ * @param[in]     type        alarm mode @ref e_alarmType
+ * @param[in]     time        time (in seconds) to emergency alarm start (@ref alarm_set)
+ * @param[in]     timeout     BLE connection timeout (@ref alarm_set)
+ * @param[in]     escalation  ticks after which alarm is sent again with next stronger type, 0
+ *                            disables escalation
+ *
+ * @return false if type is not ALARM_SOFT, ALARM_MEDIUM or ALARM_HARD
+ */
+bool alarm_scheduler_arm(s_alarmScheduler *sched, s_alarmTimer *timer, uint64_t at,
+    e_alarmType type, uint32_t time, uint16_t timeout, uint32_t escalation);
+
+/**
+ * @brief Cancel alarm.
+ *
+ * If alarm was already sent to the mask, alarm_off frame is passed to handler.
+ *
+ * @param[in,out] sched scheduler instance
+ * @param[in,out] timer timer instance
+ *
+ * @return false if alarm was neither pending nor set on the mask
+ */
+bool alarm_scheduler_cancel(s_alarmScheduler *sched, s_alarmTimer *timer);
+
+/**
+ * @brief Process due alarms.
+ *
+ * @param[in,out] sched scheduler instance
+ * @param[in]     now   current tick
+ *
+ * @return number of generated frames
+ */
+size_t alarm_scheduler_advance(s_alarmScheduler *sched, uint64_t now);
+
+/**
+ * @brief Check if alarm is waiting for its tick
+ *
+ * @param[in] timer timer instance
+ */
+bool alarm_timer_pending(const s_alarmTimer *timer);
+
+/** @} */ //End of ALARM_SCHEDULER
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_ALARM_SCHEDULER_H */
@@ -0,0 +1,213 @@
+/**
+ * @file    ic_async.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Asynchronous command/response layer
+ *
+ * Single threaded event loop which sends command frames through pluggable transports and
+ * completes every request when matching response arrives or timeout elapses. Requests are owned
+ * by the caller, so thousands of them may be in flight without threads or allocations.
+ * C++20 coroutine interface (co_await) is provided in ic_async_coro.hpp.
+ */
+
+#ifndef IC_ASYNC_H
+#define IC_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_low_level_control.h"
+#include "ic_timer_wheel.h"
+
+/** @defgroup ASYNC asynchronous command/response layer
+ *
+ * @{
+ */
+
+#define ASYNC_BUCKETS         1024  // request lookup table size, power of 2
+#define ASYNC_LOOPBACK_DEPTH  32    // loopback transport queue size, power of 2
+
+/**
+ * @brief Request result
+ */
+typedef enum{
+  ASYNC_OK = 0x00,    /*!< matching response received */
+  ASYNC_TIMEOUT,      /*!< no response in given time */
+  ASYNC_DETACHED      /*!< transport was detached from loop */
+}e_asyncResult;
+
+typedef struct s_asyncTransport s_asyncTransport;
+typedef struct s_asyncRequest s_asyncRequest;
+
+/**
+ * @brief Transport interface
+ *
+ * Embed it in own transport structure (e.g. one per mask connection).
+ */
+struct s_asyncTransport{
+  /**
+   * Write frame to characteristic, returns false if frame could not be sent.
+   */
+  bool (*send)(s_asyncTransport *transport, int uuid, const char *frame, size_t len);
+  /**
+   * Get one received frame without blocking, returns its length or 0 if there is nothing to
+   * read. May be NULL if frames are pushed with @ref async_loop_dispatch.
+   */
+  size_t (*poll)(s_asyncTransport *transport, int *uuid, char *frame, size_t len);
+  s_asyncTransport *next;   /*!< used by loop */
+  s_asyncTransport *prev;   /*!< used by loop */
+};
+
+/**
+ * @brief Completion handler
+ *
+ * @param[in] req       completed request, may be reused inside handler
+ * @param[in] result    request result
+ * @param[in] rsp_frame 20 bytes response frame, NULL if result is not @ref ASYNC_OK
+ * @param[in] user      user data given in @ref async_send
+ */
+typedef void (*f_asyncDone)(s_asyncRequest *req, e_asyncResult result, char *rsp_frame,
+    void *user);
+
+/**
+ * @brief Request in flight, owned by caller.
+ */
+struct s_asyncRequest{
+  s_twNode timer;
+  s_asyncRequest *next;
+  s_asyncRequest **pprev;
+  s_asyncTransport *transport;
+  char frame[NUC_FRAME_SIZE];
+  f_asyncDone done;
+  void *user;
+};
+
+/**
+ * @brief Event loop instance
+ */
+typedef struct{
+  s_timerWheel wheel;                     /*!< timeouts, tick = 1 ms */
+  s_asyncRequest *bucket[ASYNC_BUCKETS];
+  s_asyncTransport transports;            /*!< list of attached transports */
+  uint64_t now;                           /*!< current time [ms] */
+  size_t pending;
+}s_asyncLoop;
+
+/**
+ * @brief Loopback transport for tests.
+ *
+ * Answers every device, pulse-oximeter, alarm and status command with accepting response.
+ */
+typedef struct{
+  s_asyncTransport transport;   /*!< has to be first */
+  char queue[ASYNC_LOOPBACK_DEPTH][NUC_FRAME_SIZE];
+  uint32_t head;
+  uint32_t tail;
+  bool mute;        /*!< if true, commands are swallowed without response */
+}s_asyncLoopback;
+
+/**
+ * @brief Initialize loop
+ *
+ * @param[out]  loop  loop instance
+ * @param[in]   now   current time [ms]
+ */
+void async_loop_init(s_asyncLoop *loop, uint64_t now);
+
+/**
+ * @brief Attach transport, it will be polled by @ref async_loop_run_once.
+ *
+ * @param[in,out] loop      loop instance
+ * @param[in,out] transport transport with send (and optionally poll) set
+ */
+void async_loop_attach(s_asyncLoop *loop, s_asyncTransport *transport);
+
+/**
+ * @brief Detach transport, all its requests are completed with @ref ASYNC_DETACHED.
+ *
+ * May be called from completion handlers, also for transport being polled.
+ *
+ * @param[in,out] loop      loop instance
+ * @param[in,out] transport transport instance
+ */
+void async_loop_detach(s_asyncLoop *loop, s_asyncTransport *transport);
+
+/**
+ * @brief Send command and wait for response asynchronously.
+ *
+ * Handler is never called from inside this function. Request storage needs no initialization
+ * and must not be in flight; after this function returns @ref async_cancel is safe to call on it
+ * whether the request was sent or not.
+ *
+ * @param[in,out] loop        loop instance
+ * @param[out]    req         request storage, must stay valid until completion
+ * @param[in]     transport   attached transport
+ * @param[in]     frame       20 bytes command frame
+ * @param[in]     uuid        characteristic returned by frame builder
+ * @param[in]     timeout_ms  response timeout [ms]
+ * @param[in]     done        completion handler
+ * @param[in]     user        user data passed to handler
+ *
+ * @return false if transport refused the frame or request with the same command and id is
+ * already in flight on the transport
+ */
+bool async_send(s_asyncLoop *loop, s_asyncRequest *req, s_asyncTransport *transport,
+    const char *frame, int uuid, uint32_t timeout_ms, f_asyncDone done, void *user);
+
+/**
+ * @brief Forget request without calling its handler.
+ *
+ * @param[in,out] loop  loop instance
+ * @param[in,out] req   request
+ *
+ * @return false if request was not in flight
+ */
+bool async_cancel(s_asyncLoop *loop, s_asyncRequest *req);
+
+/**
+ * @brief Pass received frame to the loop (for push driven transports).
+ *
+ * @param[in,out] loop      loop instance
+ * @param[in]     transport transport on which frame was received
+ * @param[in]     frame     received frame
+ * @param[in]     len       frame length
+ *
+ * @return true if frame completed a request
+ */
+bool async_loop_dispatch(s_asyncLoop *loop, s_asyncTransport *transport, char *frame, size_t len);
+
+/**
+ * @brief One loop iteration: poll attached transports and expire timed out requests.
+ *
+ * @param[in,out] loop  loop instance
+ * @param[in]     now   current time [ms]
+ *
+ * @return number of completed requests
+ */
+size_t async_loop_run_once(s_asyncLoop *loop, uint64_t now);
+
+/**
+ * @brief Number of requests in flight
+ *
+ * @param[in] loop loop instance
+ */
+size_t async_loop_pending(const s_asyncLoop *loop);
+
+/**
+ * @brief Initialize loopback transport
+ *
+ * @param[out] loopback transport instance
+ */
+void async_loopback_init(s_asyncLoopback *loopback);
+
+/** @} */ //End of ASYNC
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_ASYNC_H */
@@ -0,0 +1,123 @@
+/**
+ * @file    ic_async_coro.hpp
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   C++20 coroutine interface of asynchronous command/response layer
+ *
+ * Header only wrapper of @ref ASYNC module. Coroutine suspended on nuc::send() is resumed from
+ * async_loop_run_once()/async_loop_dispatch() on the loop thread.
+ *
+ * Example:
+ * @code
+ *  nuc::task blink(s_asyncLoop *loop, s_asyncTransport *mask, uint16_t id){
+ *    char frame[NUC_FRAME_SIZE];
+ *    size_t len = sizeof(frame);
+ *    int uuid = vibrator_ON(frame, &len, id);
+ *
+ *    nuc::response rsp = co_await nuc::send(loop, mask, frame, uuid, 500);
+ *    if(rsp.result != ASYNC_OK){
+ *      errorHandle();
+ *    }
+ *  }
+ * @endcode
+ */
+
+#ifndef IC_ASYNC_CORO_HPP
+#define IC_ASYNC_CORO_HPP
+
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include "ic_async.h"
+
+namespace nuc {
+
+/**
+ * @brief Result of awaited command
+ */
+struct response{
+  e_asyncResult result;       /*!< @ref ASYNC_OK if frame holds matching response */
+  bool sent;                  /*!< false if transport refused command, result is meaningless */
+  char frame[NUC_FRAME_SIZE];
+};
+
+/**
+ * @brief Awaitable command exchange, created by @ref send.
+ */
+class send_awaiter{
+  public:
+    send_awaiter(s_asyncLoop *loop, s_asyncTransport *transport, const char *frame, int uuid,
+        uint32_t timeout_ms) : loop_(loop), transport_(transport), uuid_(uuid),
+      timeout_ms_(timeout_ms){
+      std::memcpy(frame_, frame, NUC_FRAME_SIZE);
+      req_.pprev = nullptr;
+      rsp_.result = ASYNC_TIMEOUT;
+      rsp_.sent = false;
+    }
+
+    send_awaiter(const send_awaiter &) = delete;
+    send_awaiter &operator=(const send_awaiter &) = delete;
+
+    ~send_awaiter(){
+      async_cancel(loop_, &req_);
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle){
+      handle_ = handle;
+      rsp_.sent = async_send(loop_, &req_, transport_, frame_, uuid_, timeout_ms_, &done, this);
+      return rsp_.sent;
+    }
+
+    response await_resume() const noexcept { return rsp_; }
+
+  private:
+    static void done(s_asyncRequest *, e_asyncResult result, char *rsp_frame, void *user){
+      send_awaiter *self = static_cast<send_awaiter *>(user);
+      self->rsp_.result = result;
+      if(rsp_frame) std::memcpy(self->rsp_.frame, rsp_frame, NUC_FRAME_SIZE);
+      self->handle_.resume();
+    }
+
+    s_asyncLoop *loop_;
+    s_asyncTransport *transport_;
+    int uuid_;
+    uint32_t timeout_ms_;
+    char frame_[NUC_FRAME_SIZE];
+    s_asyncRequest req_;
+    response rsp_;
+    std::coroutine_handle<> handle_;
+};
+
+/**
+ * @brief Send command and suspend until matching response arrives or timeout elapses.
+ *
+ * @param[in] loop        loop instance
+ * @param[in] transport   attached transport
+ * @param[in] frame       20 bytes command frame
+ * @param[in] uuid        characteristic returned by frame builder
+ * @param[in] timeout_ms  response timeout [ms]
+ */
+inline send_awaiter send(s_asyncLoop *loop, s_asyncTransport *transport, const char *frame,
+    int uuid, uint32_t timeout_ms){
+  return send_awaiter(loop, transport, frame, uuid, timeout_ms);
+}
+
+/**
+ * @brief Fire and forget coroutine type - starts immediately, frees itself when finished.
+ */
+struct task{
+  struct promise_type{
+    task get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+} // namespace nuc
+
+#endif /* !IC_ASYNC_CORO_HPP */
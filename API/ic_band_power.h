@@ -0,0 +1,133 @@
+/**
+ * @file    ic_band_power.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Sliding window EEG band power
+ *
+ * Band powers (delta, theta, alpha, sigma, beta) of Hann windowed EEG over sliding window,
+ * updated every hop. DFT bins of the bands are kept by recursive sliding DFT, so every sample
+ * costs a fixed number of operations regardless of hop and overlap, and nothing is allocated per
+ * hop. All eight channels are processed at once (vector lanes).
+ */
+
+#ifndef IC_BAND_POWER_H
+#define IC_BAND_POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_stream_decoder.h"
+
+/** @defgroup BAND_POWER EEG band power
+ *
+ * @{
+ */
+
+#define BAND_POWER_MAX_WINDOW 1024  // samples
+#define BAND_POWER_MAX_BINS   128   // DFT bins between lowest and highest band edge (+2)
+
+/**
+ * @brief EEG bands
+ */
+typedef enum{
+  EEG_BAND_DELTA = 0x00,
+  EEG_BAND_THETA,
+  EEG_BAND_ALPHA,
+  EEG_BAND_SIGMA,
+  EEG_BAND_BETA,
+  EEG_BANDS
+}e_eegBand;
+
+/**
+ * @brief Engine specification
+ */
+typedef struct{
+  float sample_rate;          /*!< [Hz] */
+  uint16_t window;            /*!< window length [samples] */
+  uint16_t hop;               /*!< samples between outputs */
+  float edge[EEG_BANDS+1];    /*!< band edges [Hz], band i is edge[i]..edge[i+1] */
+}s_bandPowerSpec;
+
+/**
+ * @brief Engine plan (shared, read only after @ref band_power_plan)
+ */
+typedef struct{
+  uint16_t window;
+  uint16_t hop;
+  uint16_t bin_lo;                    /*!< first kept bin */
+  uint16_t no_of_bins;
+  uint16_t band_bin[EEG_BANDS+1];     /*!< band i covers kept bins band_bin[i]..band_bin[i+1]-1 */
+  float scale;                        /*!< |bin|^2 to band power [input unit^2] */
+  float rot_re[BAND_POWER_MAX_BINS];  /*!< exp(j*2*pi*k/window) */
+  float rot_im[BAND_POWER_MAX_BINS];
+}s_bandPowerPlan;
+
+/**
+ * @brief Engine state of one device
+ */
+typedef struct{
+  float history[BAND_POWER_MAX_WINDOW][EEG_CHANNELS];
+  float re[BAND_POWER_MAX_BINS][EEG_CHANNELS];
+  float im[BAND_POWER_MAX_BINS][EEG_CHANNELS];
+  uint16_t pos;
+  uint16_t since_hop;
+  uint32_t filled;
+  uint32_t since_resync;
+}s_bandPowerState;
+
+/**
+ * @brief Band powers of all channels for one hop
+ */
+typedef struct{
+  float power[EEG_BANDS][EEG_CHANNELS];
+}s_bandPower;
+
+/**
+ * @brief Default sleep bands: 0.5, 4, 8, 12, 16, 30 Hz
+ *
+ * @param[out]  spec        specification
+ * @param[in]   sample_rate [Hz]
+ * @param[in]   window      window length [samples]
+ * @param[in]   hop         samples between outputs
+ */
+void band_power_default_spec(s_bandPowerSpec *spec, float sample_rate, uint16_t window,
+    uint16_t hop);
+
+/**
+ * @brief Prepare plan.
+ *
+ * @return false if window, hop or band edges are out of range
+ */
+bool band_power_plan(s_bandPowerPlan *plan, const s_bandPowerSpec *spec);
+
+/**
+ * @brief Reset device state (e.g. after gap in stream)
+ */
+void band_power_reset(s_bandPowerState *state);
+
+/**
+ * @brief Process EEG samples of all channels.
+ *
+ * @param[in]     plan    engine plan
+ * @param[in,out] state   device state
+ * @param[in]     channel channel columns (e.g. filtered s_eegColumnsUv)
+ * @param[in]     count   number of samples in every column
+ * @param[out]    out     band powers, one per completed hop once window is filled; room for
+ *                        count/hop + 1 entries
+ *
+ * @return number of band power outputs
+ */
+size_t band_power_process(const s_bandPowerPlan *plan, s_bandPowerState *state,
+    const float *const channel[EEG_CHANNELS], size_t count, s_bandPower *out);
+
+/** @} */ //End of BAND_POWER
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_BAND_POWER_H */
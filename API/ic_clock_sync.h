@@ -0,0 +1,131 @@
+/**
+ * @file    ic_clock_sync.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Device to host clock synchronization
+ *
+ * Per device clock model: host_time = offset + (1 + skew)*device_time. Model is estimated
+ * incrementally from (device time stamp, host receive time) pairs. Receive time is delayed by
+ * variable BLE latency, so only the minimum-delay pair of every window takes part in exponentially
+ * weighted least squares fit. Window minima which do not fit the model are rejected as outliers:
+ * minima above the model (whole window congested) are tolerated much longer than minima below
+ * it, which latency cannot explain and which mean that device clock stepped.
+ * Memory and time per pair are constant.
+ */
+
+#ifndef IC_CLOCK_SYNC_H
+#define IC_CLOCK_SYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup CLOCK_SYNC device clock synchronization
+ *
+ * @{
+ */
+
+#define CLOCK_SYNC_MIN_WINDOWS  3   // windows needed before skew is estimated
+#define CLOCK_SYNC_MAX_DELAYED  30  // consecutive windows above model (congestion) before refit
+#define CLOCK_SYNC_MAX_EARLY    3   // consecutive windows below model (clock step) before refit
+
+/**
+ * @brief Clock model of one device
+ */
+typedef struct{
+  /// ---===CONFIGURATION===--- ///
+  double us_per_tick;         /*!< nominal device tick length [us] */
+  uint64_t window;            /*!< window length [device ticks] */
+  double forget;              /*!< weight of previous windows (0..1] */
+  int64_t gate_us;            /*!< minimal outlier threshold [us] */
+
+  /// ---===CURRENT WINDOW===--- ///
+  bool started;
+  uint64_t dev_ref;           /*!< first device time stamp */
+  int64_t host_ref;           /*!< first host time [us] */
+  uint64_t window_start;
+  double win_x;               /*!< device time of minimum delay pair [us from dev_ref] */
+  double win_d;               /*!< minimum of host - device time [us] */
+  bool win_valid;
+
+  /// ---===REGRESSION===--- ///
+  double weight;
+  double mean_x;
+  double mean_d;
+  double var_x;
+  double cov_xd;
+  double residual;            /*!< exponentially weighted mean absolute residual [us] */
+  double skew;
+  uint32_t windows;           /*!< accepted windows */
+  uint32_t outliers;          /*!< rejected windows */
+  uint32_t delayed;           /*!< consecutive windows rejected above model */
+  uint32_t early;             /*!< consecutive windows rejected below model */
+}s_clockSync;
+
+/**
+ * @brief Initialize clock model
+ *
+ * @param[out]  cs              model instance
+ * @param[in]   ticks_per_sec   nominal device time stamp frequency [Hz]
+ * @param[in]   window          window length [device ticks], e.g. 2 s of ticks
+ * @param[in]   forget          weight of previous windows, e.g. 0.99 (1 - no forgetting)
+ * @param[in]   gate_us         minimal difference from model [us] which makes window an outlier
+ */
+void clock_sync_init(s_clockSync *cs, uint32_t ticks_per_sec, uint64_t window, double forget,
+    int64_t gate_us);
+
+/**
+ * @brief Add (device time stamp, host receive time) pair.
+ *
+ * @param[in,out] cs      model instance
+ * @param[in]     dev_ts  unwrapped device time stamp (@ref stream_tracker_process)
+ * @param[in]     host_us host receive time [us]
+ *
+ * @return true if window was closed and model updated
+ */
+bool clock_sync_add(s_clockSync *cs, uint64_t dev_ts, int64_t host_us);
+
+/**
+ * @brief Model is ready for conversion (at least one window accepted).
+ *
+ * @param[in] cs model instance
+ */
+bool clock_sync_valid(const s_clockSync *cs);
+
+/**
+ * @brief Convert device time stamp to host time [us]
+ *
+ * @param[in] cs      model instance
+ * @param[in] dev_ts  unwrapped device time stamp
+ */
+int64_t clock_sync_to_host(const s_clockSync *cs, uint64_t dev_ts);
+
+/**
+ * @brief Convert device time stamps to host time in bulk.
+ *
+ * @param[in]   cs      model instance
+ * @param[in]   dev_ts  unwrapped device time stamps
+ * @param[in]   count   number of time stamps
+ * @param[out]  host_us host times [us]
+ */
+void clock_sync_convert(const s_clockSync *cs, const uint64_t *dev_ts, size_t count,
+    int64_t *host_us);
+
+/**
+ * @brief Estimated skew (e.g. 20e-6 if device clock is 20 ppm slower than host clock).
+ *
+ * @param[in] cs model instance
+ */
+double clock_sync_skew(const s_clockSync *cs);
+
+/** @} */ //End of CLOCK_SYNC
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_CLOCK_SYNC_H */
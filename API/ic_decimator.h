@@ -0,0 +1,111 @@
+/**
+ * @file    ic_decimator.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming polyphase decimator of EEG channels
+ *
+ * Rational rate change up/down (integer decimation with up = 1) by polyphase FIR: anti-alias
+ * Kaiser windowed sinc is designed once and split into up phases, every output costs one phase
+ * (taps multiply-adds) regardless of the factors. Stopband starts where aliases would fold into
+ * the passband, so only the transition band (above passband edge) may contain aliases. All eight
+ * channels are filtered at once (vector lanes); filter history and phase are kept per device, so
+ * batches of any length can be fed.
+ *
+ * With the default specification a phase has about 25*down/up taps, so integer decimation by up
+ * to 10 fits in @ref DECIMATOR_MAX_TAPS; larger factors have to be cascaded (e.g. 250 Hz to 10 Hz
+ * as 5 and 5) or given a wider transition band.
+ */
+
+#ifndef IC_DECIMATOR_H
+#define IC_DECIMATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_stream_decoder.h"
+
+/** @defgroup DECIMATOR Polyphase decimator
+ *
+ * @{
+ */
+
+#define DECIMATOR_MAX_TAPS    255   // taps per phase
+#define DECIMATOR_MAX_COEFS   2048  // up*taps
+
+/**
+ * @brief Decimator specification
+ */
+typedef struct{
+  uint8_t up;                   /*!< interpolation factor */
+  uint8_t down;                 /*!< decimation factor */
+  uint8_t taps;                 /*!< taps per phase, 0 - from attenuation and transition width */
+  float passband;               /*!< passband edge as part of output Nyquist frequency */
+  float attenuation;            /*!< stopband attenuation [dB] (Kaiser window) */
+}s_decimatorSpec;
+
+/**
+ * @brief Decimator (shared, read only after @ref decimator_design)
+ */
+typedef struct{
+  uint8_t up;
+  uint8_t down;
+  uint8_t taps;
+  float coef[DECIMATOR_MAX_COEFS];  /*!< coef[phase*taps + j], j = 0 is applied to the oldest
+                                         sample */
+}s_decimator;
+
+/**
+ * @brief Decimator state of one device
+ */
+typedef struct{
+  float history[2*DECIMATOR_MAX_TAPS][EEG_CHANNELS];  /*!< mirrored, window is always contiguous */
+  uint8_t pos;
+  uint16_t phase;
+}s_decimatorState;
+
+/**
+ * @brief Default specification: 0.8 passband, 80 dB, automatic number of taps
+ *
+ * @param[out]  spec  specification
+ * @param[in]   up    interpolation factor
+ * @param[in]   down  decimation factor
+ */
+void decimator_default_spec(s_decimatorSpec *spec, uint8_t up, uint8_t down);
+
+/**
+ * @brief Design decimator.
+ *
+ * @return false if factors or number of taps (also automatic one) are out of range
+ */
+bool decimator_design(s_decimator *dec, const s_decimatorSpec *spec);
+
+/**
+ * @brief Reset device state (e.g. after gap in stream)
+ */
+void decimator_reset(s_decimatorState *state);
+
+/**
+ * @brief Resample samples of all channels.
+ *
+ * @param[in]     dec     decimator
+ * @param[in,out] state   device state
+ * @param[in]     in      input channel columns
+ * @param[in]     count   number of samples in every input column
+ * @param[out]    out     output channel columns, room for count*up/down + 1 samples
+ *
+ * @return number of output samples
+ */
+size_t decimator_process(const s_decimator *dec, s_decimatorState *state,
+    const float *const in[EEG_CHANNELS], size_t count, float *const out[EEG_CHANNELS]);
+
+/** @} */ //End of DECIMATOR
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_DECIMATOR_H */
@@ -0,0 +1,100 @@
+/**
+ * @file    ic_eeg_filter.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   EEG filter bank (mains notch + Butterworth bandpass)
+ *
+ * Cascade of biquads applied to all eight EEG channels at once - channels are vector lanes.
+ * Filter is designed once (@ref eeg_filter_design) and shared by all devices, every device keeps
+ * only its own state. Input and output are channel columns (@ref s_eegColumnsUv).
+ */
+
+#ifndef IC_EEG_FILTER_H
+#define IC_EEG_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_stream_decoder.h"
+
+/** @defgroup EEG_FILTER EEG filter bank
+ *
+ * @{
+ */
+
+#define EEG_FILTER_MAX_SECTIONS 10
+#define EEG_FILTER_MAX_ORDER    8   // of highpass and lowpass part
+
+/**
+ * @brief Filter specification
+ */
+typedef struct{
+  float sample_rate;    /*!< [Hz] */
+  float mains;          /*!< mains frequency (50 or 60) [Hz], 0 - no notch */
+  float notch_q;        /*!< notch quality factor, e.g. 30 */
+  bool notch_harmonic;  /*!< notch also at 2*mains (if below Nyquist) */
+  float highpass;       /*!< bandpass lower edge [Hz], 0 - no highpass */
+  float lowpass;        /*!< bandpass upper edge [Hz], 0 - no lowpass */
+  uint8_t order;        /*!< Butterworth order of highpass and lowpass part, even, 2..8 */
+}s_eegFilterSpec;
+
+/**
+ * @brief Designed filter (shared, read only after design)
+ */
+typedef struct{
+  uint8_t no_of_sections;
+  float b0[EEG_FILTER_MAX_SECTIONS];
+  float b1[EEG_FILTER_MAX_SECTIONS];
+  float b2[EEG_FILTER_MAX_SECTIONS];
+  float a1[EEG_FILTER_MAX_SECTIONS];
+  float a2[EEG_FILTER_MAX_SECTIONS];
+}s_eegFilter;
+
+/**
+ * @brief Filter state of one device
+ */
+typedef struct{
+  float z1[EEG_FILTER_MAX_SECTIONS][EEG_CHANNELS];
+  float z2[EEG_FILTER_MAX_SECTIONS][EEG_CHANNELS];
+}s_eegFilterState;
+
+/**
+ * @brief Design filter.
+ *
+ * @param[out]  filter  filter
+ * @param[in]   spec    specification
+ *
+ * @return false if specification is invalid (frequencies above Nyquist, highpass edge not below
+ *         lowpass edge, odd or too high order)
+ */
+bool eeg_filter_design(s_eegFilter *filter, const s_eegFilterSpec *spec);
+
+/**
+ * @brief Reset device state (e.g. after gap in stream).
+ *
+ * @param[out] state device filter state
+ */
+void eeg_filter_reset(s_eegFilterState *state);
+
+/**
+ * @brief Filter samples of all channels in place.
+ *
+ * @param[in]     filter  designed filter
+ * @param[in,out] state   device filter state
+ * @param[in,out] channel channel columns
+ * @param[in]     count   number of samples in every column
+ */
+void eeg_filter_process(const s_eegFilter *filter, s_eegFilterState *state,
+    float *const channel[EEG_CHANNELS], size_t count);
+
+/** @} */ //End of EEG_FILTER
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_EEG_FILTER_H */
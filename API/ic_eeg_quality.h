@@ -0,0 +1,124 @@
+/**
+ * @file    ic_eeg_quality.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming EEG signal quality detector
+ *
+ * Raw EEG samples are checked over short windows (quality epochs). Every epoch gives one bitmask
+ * per condition with bit n set for channel n: clipping at int16 rails, flatline (peak-to-peak
+ * below threshold), excessive amplitude and mains dominance (power at mains frequency above
+ * given part of signal variance). All eight channels are reduced at once (vector lanes), so
+ * host can prompt re-fit of the band while the night is recorded.
+ */
+
+#ifndef IC_EEG_QUALITY_H
+#define IC_EEG_QUALITY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_stream_decoder.h"
+
+/** @defgroup EEG_QUALITY EEG signal quality
+ *
+ * @{
+ */
+
+#define EEG_QUALITY_MAX_WINDOW  1024  // samples
+
+/**
+ * @brief Detector specification (amplitudes in raw LSB)
+ */
+typedef struct{
+  float sample_rate;        /*!< [Hz] */
+  uint16_t window;          /*!< quality epoch length [samples] */
+  float mains;              /*!< mains frequency [Hz] */
+  int16_t clip_level;       /*!< |sample| >= clip_level is clipped */
+  uint16_t clip_samples;    /*!< clipped samples which flag channel */
+  uint16_t flat_p2p;        /*!< peak-to-peak <= flat_p2p is flatline */
+  uint16_t max_p2p;         /*!< peak-to-peak >= max_p2p is excessive amplitude */
+  float line_ratio;         /*!< mains power/variance which flags line noise */
+}s_eegQualitySpec;
+
+/**
+ * @brief Detector plan (shared, read only after @ref eeg_quality_plan)
+ */
+typedef struct{
+  s_eegQualitySpec spec;
+  float cos[EEG_QUALITY_MAX_WINDOW];  /*!< mains reference over the window */
+  float sin[EEG_QUALITY_MAX_WINDOW];
+}s_eegQualityPlan;
+
+/**
+ * @brief Detector state of one device
+ */
+typedef struct{
+  int16_t min[EEG_CHANNELS];
+  int16_t max[EEG_CHANNELS];
+  int16_t clip[EEG_CHANNELS];
+  float ref[EEG_CHANNELS];          /*!< first sample of epoch, keeps sums small */
+  float sum[EEG_CHANNELS];
+  float sum2[EEG_CHANNELS];
+  float re[EEG_CHANNELS];
+  float im[EEG_CHANNELS];
+  uint16_t pos;                     /*!< samples of current epoch */
+  uint32_t index;
+}s_eegQualityState;
+
+/**
+ * @brief Quality of one epoch, bit n of every mask is channel n
+ */
+typedef struct{
+  uint32_t index;           /*!< epoch number since reset */
+  uint8_t clipped;
+  uint8_t flat;
+  uint8_t excessive;
+  uint8_t line_noise;
+  uint8_t bad;              /*!< any of the above */
+}s_eegQuality;
+
+/**
+ * @brief Default specification: 1 s epochs, 50 Hz mains
+ *
+ * @param[out]  spec        specification
+ * @param[in]   sample_rate [Hz]
+ */
+void eeg_quality_default_spec(s_eegQualitySpec *spec, float sample_rate);
+
+/**
+ * @brief Prepare plan.
+ *
+ * @return false if window or mains frequency is out of range
+ */
+bool eeg_quality_plan(s_eegQualityPlan *plan, const s_eegQualitySpec *spec);
+
+/**
+ * @brief Reset device state (e.g. after gap in stream)
+ */
+void eeg_quality_reset(s_eegQualityState *state);
+
+/**
+ * @brief Process raw EEG samples of all channels.
+ *
+ * @param[in]     plan    detector plan
+ * @param[in,out] state   device state
+ * @param[in]     channel raw channel columns (s_eegColumns)
+ * @param[in]     count   number of samples in every column
+ * @param[out]    out     completed epochs; room for count/window + 1 entries
+ *
+ * @return number of completed epochs
+ */
+size_t eeg_quality_process(const s_eegQualityPlan *plan, s_eegQualityState *state,
+    const int16_t *const channel[EEG_CHANNELS], size_t count, s_eegQuality *out);
+
+/** @} */ //End of EEG_QUALITY
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_EEG_QUALITY_H */
@@ -16,11 +16,13 @@ extern "C" {
 #endif
 
 #define UUID_LENGTH             36  //
+#define UUID_BINARY_LENGTH      16  // 128 bit UUID in bytes
 #define NEUROON_CHARECTERISTICS 5   // Dear God, forgive me for it being a fixed value
 #define DFU_CHARECTERISTICS     4   //
 #define NO_CHARECTERISTICS NEUROON_CHARECTERISTICS+DFU_CHARECTERISTICS
 
 #define SYNC_BYTE   0xEE
+#define NUC_FRAME_SIZE 20  // size of every command, response and data frame
 
 #include "include/ic_frame_handle_batch.h"
 
@@ -78,6 +80,48 @@ typedef union {
 bool neuroon_cmd_frame_validate (uint8_t *data, uint16_t len);
 bool nuc_init(char characteristics[NO_CHARECTERISTICS][UUID_LENGTH+1]);
 
+/**
+ * Binary 128 bit service UUIDs (bytes in string order). Characteristic UUID is the service UUID
+ * with bytes 2-3 replaced by 16 bit characteristic UUID.
+ */
+extern const uint8_t nuc_neuroon_service_uuid[UUID_BINARY_LENGTH];
+extern const uint8_t nuc_dfu_service_uuid[UUID_BINARY_LENGTH];
+
+/**
+ * @brief Map 16 bit characteristic UUID (e.g. 0x0302) to characteristic (constant time).
+ *
+ * @return characteristic or @ref ERROR_UUID if UUID is unknown
+ */
+e_characteristics nuc_characteristic_from_uuid16(uint16_t uuid);
+
+/**
+ * @brief Map raw 128 bit characteristic UUID to characteristic (constant time).
+ *
+ * @param[in] uuid          16 bytes UUID
+ * @param[in] little_endian true if bytes are in reversed order (as in ATT PDUs), false if in
+ *                          string order
+ *
+ * @return characteristic or @ref ERROR_UUID if UUID does not belong to Neuroon/DFU service
+ */
+e_characteristics nuc_characteristic_from_uuid128(const uint8_t *uuid, bool little_endian);
+
+/**
+ * @brief Route notification to characteristic and validate its frame in one step.
+ *
+ * Response and status frames are checked with @ref neuroon_cmd_frame_validate, data stream
+ * frames must have @ref NUC_FRAME_SIZE bytes. Notifications on RX characteristics are rejected.
+ *
+ * @param[in] uuid          raw characteristic UUID
+ * @param[in] uuid_len      2 (16 bit UUID) or @ref UUID_BINARY_LENGTH
+ * @param[in] little_endian byte order of uuid
+ * @param[in] data          notification value
+ * @param[in] len           notification length
+ *
+ * @return characteristic or @ref ERROR_UUID if UUID is unknown or frame is invalid
+ */
+e_characteristics nuc_notification_route(const uint8_t *uuid, size_t uuid_len, bool little_endian,
+    uint8_t *data, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
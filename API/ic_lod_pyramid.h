@@ -0,0 +1,130 @@
+/**
+ * @file    ic_lod_pyramid.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Min/max/mean level-of-detail pyramid of EEG recordings
+ *
+ * Level 0 keeps min, max and mean of every channel over buckets of base samples, level k over
+ * buckets of base*2^k samples; a bucket of level k+1 is merged from two buckets of level k as soon
+ * as both are complete, so pyramid is built incrementally while frames are decoded. Any zoom
+ * window is rendered from a few buckets per pixel (largest aligned buckets which fit in the
+ * pixel), independently of the number of samples. Pyramid can be saved next to the recording and
+ * loaded back (and appended to) later.
+ */
+
+#ifndef IC_LOD_PYRAMID_H
+#define IC_LOD_PYRAMID_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "ic_stream_decoder.h"
+
+/** @defgroup LOD_PYRAMID Level-of-detail pyramid
+ *
+ * @{
+ */
+
+#define LOD_MAX_LEVELS  24
+
+/**
+ * @brief Summary of one bucket of all channels
+ */
+typedef struct{
+  int16_t min[EEG_CHANNELS];
+  int16_t max[EEG_CHANNELS];
+  float mean[EEG_CHANNELS];
+}s_lodBucket;
+
+/**
+ * @brief Rendered pixel of one channel
+ */
+typedef struct{
+  int16_t min;
+  int16_t max;
+  float mean;
+}s_lodPoint;
+
+/**
+ * @brief Pyramid of one recording
+ *
+ * Fields must not be accessed directly.
+ */
+typedef struct{
+  uint32_t base;                        /*!< samples in level 0 bucket */
+  uint64_t samples;                     /*!< samples appended */
+  uint8_t no_of_levels;                 /*!< levels with at least one bucket */
+  s_lodBucket *level[LOD_MAX_LEVELS];
+  size_t count[LOD_MAX_LEVELS];         /*!< complete buckets of level */
+  size_t capacity[LOD_MAX_LEVELS];
+  s_lodBucket partial;                  /*!< level 0 bucket being filled */
+  int64_t sum[EEG_CHANNELS];            /*!< sums of partial bucket */
+}s_lodPyramid;
+
+/**
+ * @brief Initialize empty pyramid.
+ *
+ * @param[out]  lod   pyramid
+ * @param[in]   base  samples in level 0 bucket, power of 2
+ *
+ * @return false if base is not a power of 2
+ */
+bool lod_pyramid_init(s_lodPyramid *lod, uint32_t base);
+
+/**
+ * @brief Free memory of pyramid.
+ */
+void lod_pyramid_free(s_lodPyramid *lod);
+
+/**
+ * @brief Append raw EEG samples of all channels (@ref stream_decode_eeg).
+ *
+ * @return false if memory could not be allocated (pyramid stays consistent without new samples)
+ */
+bool lod_pyramid_append(s_lodPyramid *lod, const int16_t *const channel[EEG_CHANNELS],
+    size_t count);
+
+/**
+ * @brief Render channel samples from..to (exclusive) into pixels.
+ *
+ * @param[in]   lod     pyramid
+ * @param[in]   channel channel number
+ * @param[in]   from    first sample
+ * @param[in]   to      end sample
+ * @param[in]   pixels  number of pixels
+ * @param[out]  out     pixels (room for pixels entries)
+ *
+ * @return number of rendered pixels (less than pixels if window reaches behind the recording)
+ */
+size_t lod_pyramid_render(const s_lodPyramid *lod, uint8_t channel, uint64_t from, uint64_t to,
+    size_t pixels, s_lodPoint *out);
+
+/**
+ * @brief Save pyramid to file.
+ *
+ * @return false on write error
+ */
+bool lod_pyramid_save(const s_lodPyramid *lod, FILE *fp);
+
+/**
+ * @brief Load pyramid saved by @ref lod_pyramid_save.
+ *
+ * @param[out]  lod   pyramid (free it with @ref lod_pyramid_free)
+ * @param[in]   fp    file
+ *
+ * @return false on read error or if file is not a pyramid
+ */
+bool lod_pyramid_load(s_lodPyramid *lod, FILE *fp);
+
+/** @} */ //End of LOD_PYRAMID
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_LOD_PYRAMID_H */
@@ -0,0 +1,137 @@
+/**
+ * @file    ic_mask_emulator.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Emulated Neuroon mask - command side
+ *
+ * Device side counterpart of frame builders. Emulator parses device, pulse-oximeter, emergency
+ * alarm and status commands, tracks LEDs, vibrator, AFE4400 and alarm state and answers with
+ * responses correlated by id, after configurable latency and with configurable loss. Emulator
+ * has fixed size and does no allocations, so thousands of them may run in one process. It
+ * implements @ref s_asyncTransport, so it can be attached directly to @ref ASYNC loop.
+ */
+
+#ifndef IC_MASK_EMULATOR_H
+#define IC_MASK_EMULATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_async.h"
+#include "ic_low_level_control.h"
+#include "ic_pox_shadow.h"
+
+/** @defgroup MASK_EMULATOR emulated mask
+ *
+ * @{
+ */
+
+#define MASK_EMU_QUEUE      16  // responses waiting for delivery, power of 2
+#define MASK_EMU_INTENSITIES 7  // devices with intensity (all but power LED)
+
+/**
+ * @brief Emulator configuration
+ */
+typedef struct{
+  uint32_t latency_ms;      /*!< minimal response latency */
+  uint32_t jitter_ms;       /*!< maximal random latency added to latency_ms */
+  uint16_t loss_permille;   /*!< number of lost responses per 1000 commands */
+  uint32_t seed;            /*!< random generator seed, 0 is replaced by 1 */
+  const uint64_t *clock;    /*!< time [ms] used by transport interface, e.g. &loop->now */
+}s_maskEmuConfig;
+
+/**
+ * @brief Response waiting for delivery
+ */
+typedef struct{
+  char frame[NUC_FRAME_SIZE];
+  uint64_t due;
+  int uuid;       /*!< RESPONSE_UUID, STATUS_STREAM_UUID for status */
+}s_maskEmuResponse;
+
+/**
+ * @brief Emulated mask
+ */
+typedef struct{
+  s_asyncTransport transport;     /*!< has to be first */
+  s_maskEmuConfig config;
+  uint32_t rng;
+
+  /// ---===DEVICES===--- ///
+  s_devsFunc devs_func;
+  uint8_t intensity[MASK_EMU_INTENSITIES];
+  uint32_t duration;              /*!< parameters of last accepted device command */
+  uint16_t period;
+
+  /// ---===PULSE-OXIMETER===--- ///
+  t_afe4400RegisterConf pox_reg[AFE4400_NO_OF_REGISTERS];
+  bool pox_initialized;
+  bool pox_powerdown;
+
+  /// ---===EMERGENCY ALARM===--- ///
+  e_alarmType alarm_type;         /*!< ALARM_OFF if alarm is not set */
+  uint32_t alarm_time;
+  uint16_t alarm_timeout;
+
+  /// ---===RESPONSES===--- ///
+  s_maskEmuResponse queue[MASK_EMU_QUEUE];
+  uint32_t head;
+  uint32_t tail;
+
+  /// ---===STATISTICS===--- ///
+  uint32_t received;              /*!< valid commands */
+  uint32_t invalid;               /*!< frames with wrong sync byte or CRC */
+  uint32_t lost;                  /*!< responses dropped (loss or full queue) */
+}s_maskEmulator;
+
+/**
+ * @brief Initialize emulator - all devices off, pulse-oximeter not initialized, no alarm.
+ *
+ * @param[out]  emu     emulator instance
+ * @param[in]   config  emulator configuration
+ */
+void mask_emu_init(s_maskEmulator *emu, const s_maskEmuConfig *config);
+
+/**
+ * @brief Receive command frame written to CMD characteristic.
+ *
+ * @param[in,out] emu   emulator instance
+ * @param[in]     frame 20 bytes command frame
+ * @param[in]     len   frame length
+ * @param[in]     now   current time [ms]
+ *
+ * @return false if frame is invalid (it is ignored then, as the mask does)
+ */
+bool mask_emu_receive(s_maskEmulator *emu, const char *frame, size_t len, uint64_t now);
+
+/**
+ * @brief Get next response which is due.
+ *
+ * @param[in,out] emu   emulator instance
+ * @param[in]     now   current time [ms]
+ * @param[out]    uuid  characteristic on which response is notified
+ * @param[out]    frame buffer for response frame
+ * @param[in]     len   buffer length
+ *
+ * @return response length or 0 if there is no response due
+ */
+size_t mask_emu_poll(s_maskEmulator *emu, uint64_t now, int *uuid, char *frame, size_t len);
+
+/**
+ * @brief Data streams active on the emulated mask (byte as in @ref status_rsp_gen_func)
+ *
+ * @param[in] emu emulator instance
+ */
+uint8_t mask_emu_active_data_streams(const s_maskEmulator *emu);
+
+/** @} */ //End of MASK_EMULATOR
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_MASK_EMULATOR_H */
@@ -0,0 +1,176 @@
+/**
+ * @file    ic_pox_shadow.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   AFE4400 register shadow
+ *
+ * Per mask copy of AFE4400 register file kept on the host. Reads of registers with known value
+ * are answered locally. Writing of a whole register profile produces frames only for registers
+ * which differ from the shadow; all of them may be sent back to back, responses are matched by
+ * command id.
+ */
+
+#ifndef IC_POX_SHADOW_H
+#define IC_POX_SHADOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_low_level_control.h"
+
+/** @defgroup POX_SHADOW AFE4400 register shadow
+ *  @ingroup PULSE_OXIMETER_CONTROL
+ *  @{
+ */
+
+#define AFE4400_NO_OF_REGISTERS 0x31  // CONTROL0 (0x00) .. DIAG (0x30)
+#define AFE4400_CONTROL0        0x00  // write only
+#define AFE4400_LED2VAL         0x2A  // first of ADC output registers (read only, volatile)
+#define AFE4400_DIAG            0x30  // read only
+
+#define POX_SHADOW_PENDING      64    // max number of register requests in flight, power of 2
+
+/**
+ * @brief Register and its configuration
+ */
+typedef struct{
+  t_afe4400Register reg;
+  t_afe4400RegisterConf reg_val;
+}s_afe4400RegisterValue;
+
+/**
+ * @brief Register request waiting for response
+ */
+typedef struct{
+  uint16_t id;
+  t_afe4400Register reg;
+  e_reqMode mode;
+  bool used;
+  t_afe4400RegisterConf reg_val;
+}s_poxShadowPending;
+
+/**
+ * @brief AFE4400 register shadow, one per mask.
+ */
+typedef struct{
+  t_afe4400RegisterConf reg_val[AFE4400_NO_OF_REGISTERS];
+  uint64_t valid;                 /*!< bit per register, value in reg_val is confirmed by mask */
+  uint64_t in_flight;             /*!< bit per register, write request is waiting for response */
+  t_afe4400RegisterConf in_flight_val[AFE4400_NO_OF_REGISTERS];
+  uint16_t in_flight_id[AFE4400_NO_OF_REGISTERS];   /*!< id of the newest write request */
+  s_poxShadowPending pending[POX_SHADOW_PENDING];
+  size_t no_of_pending;
+}s_poxShadow;
+
+/**
+ * @brief Initialize shadow - all registers are unknown.
+ *
+ * @param[out] shadow shadow instance
+ */
+void pox_shadow_init(s_poxShadow *shadow);
+
+/**
+ * @brief Forget all register values and requests in flight.
+ *
+ * Use it after mask reconnection or when responses were lost.
+ *
+ * @param[in,out] shadow shadow instance
+ */
+void pox_shadow_invalidate(s_poxShadow *shadow);
+
+/**
+ * @brief Get register value from shadow.
+ *
+ * @param[in]   shadow  shadow instance
+ * @param[in]   reg     AFE4400 register
+ * @param[out]  reg_val register configuration
+ *
+ * @return false if value is unknown - use @ref pox_shadow_read_register then
+ */
+bool pox_shadow_get(const s_poxShadow *shadow, t_afe4400Register reg,
+    t_afe4400RegisterConf *reg_val);
+
+/**
+ * @brief Build read register frame (@ref pox_read_register) and remember request.
+ *
+ * @param[in,out] shadow  shadow instance
+ * @param[out]    array   20 bytes array where frame will be stored.
+ * @param[in,out] len     as input, provides data, of how big array has been allocated.
+ *                        provides data of how much data has actually been used.
+ * @param[in]     reg     AFE4400 register
+ * @param[in]     id      command counter for commands validate purpose.
+ *
+ * @return if returned @ref ERROR_UUID it means that array is not sufficient, register is out of
+ * range or there is no place for another request in flight. In other cases returns index of UUID
+ * array (@ref nuc_init)
+ */
+int pox_shadow_read_register(s_poxShadow *shadow, char *array, size_t *len, t_afe4400Register reg,
+    uint16_t id);
+
+/**
+ * @brief Build write register frame (@ref pox_write_register) and remember request.
+ *
+ * @param[in,out] shadow  shadow instance
+ * @param[out]    array   20 bytes array where frame will be stored.
+ * @param[in,out] len     as input, provides data, of how big array has been allocated.
+ *                        provides data of how much data has actually been used.
+ * @param[in]     reg     AFE4400 register
+ * @param[in]     reg_val AFE4400 register configuration
+ * @param[in]     id      command counter for commands validate purpose.
+ *
+ * @return same as @ref pox_shadow_read_register
+ */
+int pox_shadow_write_register(s_poxShadow *shadow, char *array, size_t *len,
+    t_afe4400Register reg, t_afe4400RegisterConf reg_val, uint16_t id);
+
+/**
+ * @brief Build write frames for registers of profile which differ from shadow.
+ *
+ * Registers with confirmed or already requested value equal to profile value are skipped. All
+ * built frames may be sent without waiting for responses. If frames array is too small, call the
+ * function again after some responses arrive - registers in flight will not be repeated.
+ *
+ * @param[in,out] shadow      shadow instance
+ * @param[in]     profile     registers configuration
+ * @param[in]     count       number of profile entries
+ * @param[out]    frames      array of 20 bytes frames
+ * @param[in]     max_frames  size of frames array
+ * @param[in,out] id          command counter of first frame, incremented by every built frame
+ *
+ * @return number of built frames
+ */
+size_t pox_shadow_program(s_poxShadow *shadow, const s_afe4400RegisterValue *profile, size_t count,
+    char (*frames)[NUC_FRAME_SIZE], size_t max_frames, uint16_t *id);
+
+/**
+ * @brief Update shadow with pulse-oximeter response frame.
+ *
+ * Successful HDW_INIT or STD_VAL_INIT (@ref e_poxFuncType) resets registers on the mask, so the
+ * shadow is cleared then, together with all requests in flight - their responses no longer match.
+ * POWERDOWN_ON, POWERDOWN_OFF and SELF_TEST keep configuration registers.
+ *
+ * @param[in,out] shadow    shadow instance
+ * @param[in]     rsp_frame 20 bytes response frame
+ *
+ * @return false if frame is not valid pulse-oximeter response or does not match any request
+ */
+bool pox_shadow_response_sink(s_poxShadow *shadow, char *rsp_frame);
+
+/**
+ * @brief Number of requests waiting for response
+ *
+ * @param[in] shadow shadow instance
+ */
+size_t pox_shadow_pending(const s_poxShadow *shadow);
+
+/** @} */ //End of POX_SHADOW
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_POX_SHADOW_H */
@@ -0,0 +1,106 @@
+/**
+ * @file    ic_ppg_artifact.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Motion artifact cancellation of IR/red samples with accelerometer reference
+ *
+ * Head movement shows up in pulse-oximeter channels and in accelerometer samples of the same
+ * frames. Pulsatile part of IR and red channels is predicted from the last @ref PPG_ARTIFACT_TAPS
+ * samples of all three (gravity free) accelerometer axes by normalized LMS filter and the
+ * prediction is subtracted. Cleaned samples keep DC and ADC units, so they go straight to
+ * @ref spo2_process. Update step is regularized by minimal motion, so filter does not adapt to
+ * (and does not remove) pulse while the head is still. State has fixed size per device.
+ *
+ * @note Periodic motion at pulse rate or at its harmonics (e.g. rocking or walking in step with
+ *       heart beat) cannot be told apart from pulse: filter notches pulse component of the same
+ *       frequency together with the artifact. With 250 mg motion at pulse rate the averaged pulse
+ *       keeps about 60 % of its peak to peak amplitude, at second harmonic about 75 %. Broadband
+ *       motion leaves pulse intact.
+ */
+
+#ifndef IC_PPG_ARTIFACT_H
+#define IC_PPG_ARTIFACT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup PPG_ARTIFACT PPG motion artifact cancellation
+ *
+ * @{
+ */
+
+#define PPG_ARTIFACT_TAPS 16  // reference history per axis [samples], multiple of 8
+
+/**
+ * @brief Canceller configuration
+ */
+typedef struct{
+  float sample_rate;      /*!< [Hz] */
+  float mg_per_lsb;       /*!< accelerometer scale [mg/LSB] */
+  float mu;               /*!< NLMS step size (0..2) */
+  float min_motion;       /*!< RMS acceleration below which filter barely adapts [mg] */
+  float dc_tau;           /*!< DC (gravity, PPG baseline) tracking time constant [s] */
+}s_ppgArtifactConfig;
+
+/**
+ * @brief Canceller state of one device
+ */
+typedef struct{
+  s_ppgArtifactConfig config;
+  float dc_alpha;
+  float eps;                                  /*!< regularization of reference power */
+  float dc_ppg[2];                            /*!< IR, red */
+  float dc_acc[3];
+  float history[3][2*PPG_ARTIFACT_TAPS];      /*!< mirrored reference history [mg] */
+  float weight[2][3][PPG_ARTIFACT_TAPS];      /*!< [PPG channel][axis][tap] */
+  uint16_t pos;
+  bool started;
+}s_ppgArtifactState;
+
+/**
+ * @brief Default configuration (step 0.05, minimal motion 5 mg)
+ *
+ * @param[out]  config      configuration
+ * @param[in]   sample_rate sample rate of pulse-oximeter/accelerometer frames [Hz]
+ */
+void ppg_artifact_default_config(s_ppgArtifactConfig *config, float sample_rate);
+
+/**
+ * @brief Initialize canceller
+ *
+ * @param[out]  state   canceller state
+ * @param[in]   config  configuration
+ *
+ * @return false if configuration is invalid
+ */
+bool ppg_artifact_init(s_ppgArtifactState *state, const s_ppgArtifactConfig *config);
+
+/**
+ * @brief Clean batch of IR/red samples (e.g. columns of @ref stream_decode_other).
+ *
+ * @param[in,out] state   canceller state
+ * @param[in]     ir      IR samples
+ * @param[in]     red     red samples
+ * @param[in]     x       accelerometer samples
+ * @param[in]     y
+ * @param[in]     z
+ * @param[in]     count   number of samples
+ * @param[out]    ir_out  cleaned IR samples, may be ir
+ * @param[out]    red_out cleaned red samples, may be red
+ */
+void ppg_artifact_process(s_ppgArtifactState *state, const int32_t *ir, const int32_t *red,
+    const int16_t *x, const int16_t *y, const int16_t *z, size_t count, int32_t *ir_out,
+    int32_t *red_out);
+
+/** @} */ //End of PPG_ARTIFACT
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_PPG_ARTIFACT_H */
@@ -0,0 +1,124 @@
+/**
+ * @file    ic_restore.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Mask state restoration after reconnection
+ *
+ * Cache keeps last command frames acknowledged by the mask: devices functions (per device bit),
+ * pulse-oximeter functions and register writes, and pending emergency alarm. After reconnection
+ * it builds minimal set of frames which bring the mask back to the same state, ready to be sent
+ * in one burst.
+ */
+
+#ifndef IC_RESTORE_H
+#define IC_RESTORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_low_level_control.h"
+#include "ic_pox_shadow.h"
+
+/** @defgroup RESTORE mask state restoration
+ *
+ * @{
+ */
+
+#define RESTORE_DEVICES 8   // device bits in @ref e_deviceType
+///Maximal number of frames built by @ref restore_cache_build
+#define RESTORE_MAX_FRAMES (3+AFE4400_NO_OF_REGISTERS+RESTORE_DEVICES+1)
+#define RESTORE_PENDING 64  // commands waiting for response, power of 2, >= RESTORE_MAX_FRAMES
+
+/**
+ * @brief Cached frame
+ */
+typedef struct{
+  char frame[NUC_FRAME_SIZE];
+  uint64_t acked;   /*!< time of acknowledge [ms] */
+  bool used;
+  bool replay;      /*!< frame was built by @ref restore_cache_build */
+}s_restoreEntry;
+
+/**
+ * @brief Restoration cache, one per mask
+ */
+typedef struct{
+  s_restoreEntry pending[RESTORE_PENDING];        /*!< sent, not acknowledged commands */
+  s_restoreEntry device[RESTORE_DEVICES];         /*!< device commands in acknowledge order */
+  uint8_t owner[RESTORE_DEVICES];                 /*!< device bits still set by device[i] */
+  size_t no_of_device;
+  s_restoreEntry pox_hdw_init;
+  s_restoreEntry pox_std_val_init;
+  s_restoreEntry pox_register[AFE4400_NO_OF_REGISTERS];
+  s_restoreEntry pox_powerdown;                   /*!< last POWERDOWN_ON/POWERDOWN_OFF */
+  s_restoreEntry alarm;
+}s_restoreCache;
+
+/**
+ * @brief Initialize cache
+ *
+ * @param[out] cache cache instance
+ */
+void restore_cache_init(s_restoreCache *cache);
+
+/**
+ * @brief Remember sent command.
+ *
+ * Only device, pulse-oximeter and emergency alarm commands are kept.
+ *
+ * @param[in,out] cache cache instance
+ * @param[in]     frame 20 bytes command frame
+ *
+ * @return false if frame is not restorable command
+ */
+bool restore_cache_sent(s_restoreCache *cache, char *frame);
+
+/**
+ * @brief Process response frame.
+ *
+ * Command matching the response (@ref frame_resp_cmp) becomes part of mask state if it was
+ * accepted by the mask. HDW_INIT and STD_VAL_INIT reset AFE4400 configuration registers (as in
+ * @ref pox_shadow_response_sink), so cached register writes are dropped when they are sent by the
+ * application. Replayed frames only refresh the cache, so losing connection again in the middle
+ * of restoration loses nothing.
+ *
+ * @param[in,out] cache     cache instance
+ * @param[in]     rsp_frame 20 bytes response frame
+ * @param[in]     now       current time [ms]
+ *
+ * @return false if response does not match any sent command
+ */
+bool restore_cache_response(s_restoreCache *cache, char *rsp_frame, uint64_t now);
+
+/**
+ * @brief Build frames restoring mask state.
+ *
+ * Order of frames: pulse-oximeter initialization, registers and powerdown, devices, alarm.
+ * Finished device functions and alarms are skipped, durations and alarm time are shortened by
+ * time which elapsed since acknowledge. Devices which already run cached function are skipped.
+ * Built frames are remembered as sent, so their responses refresh the cache.
+ *
+ * @param[in,out] cache       cache instance
+ * @param[in]     current     devices functions reported by the mask after reconnection, may be
+ *                            NULL - all devices are assumed to be off then
+ * @param[in]     now         current time [ms]
+ * @param[out]    frames      array of 20 bytes frames
+ * @param[in]     max_frames  size of frames array, @ref RESTORE_MAX_FRAMES is always enough
+ * @param[in,out] id          command counter of first frame, incremented by every built frame
+ *
+ * @return number of built frames
+ */
+size_t restore_cache_build(s_restoreCache *cache, const s_devsFunc *current, uint64_t now,
+    char (*frames)[NUC_FRAME_SIZE], size_t max_frames, uint16_t *id);
+
+/** @} */ //End of RESTORE
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_RESTORE_H */
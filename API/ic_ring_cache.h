@@ -0,0 +1,145 @@
+/**
+ * @file    ic_ring_cache.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Per-device columnar ring cache of recent samples with time range queries
+ *
+ * Bounded ring of time stamped rows kept in caller provided columns (e.g. eight EEG channels, or
+ * pulse-oximeter and accelerometer columns of @ref s_otherColumns). One writer thread appends
+ * decoded batches, any number of readers query time ranges without locking: query returns
+ * pointers into the ring (at most two spans per column when range wraps), and after using them
+ * reader checks with @ref ring_cache_valid that writer did not overwrite the slice meanwhile.
+ */
+
+#ifndef IC_RING_CACHE_H
+#define IC_RING_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_stream_decoder.h"
+
+/** @defgroup RING_CACHE Ring cache of recent samples
+ *
+ * @{
+ */
+
+#define RING_CACHE_MAX_COLUMNS  8
+#define RING_CACHE_EEG_COLUMNS  EEG_CHANNELS
+#define RING_CACHE_OTHER_COLUMNS 5  // ir, red, acc_x, acc_y, acc_z
+
+/**
+ * @brief Ring cache, one per device and stream.
+ *
+ * Fields must not be accessed directly.
+ */
+typedef struct{
+  uint32_t mask;                              /*!< capacity - 1 */
+  uint8_t no_of_columns;
+  uint8_t size[RING_CACHE_MAX_COLUMNS];       /*!< column element sizes [bytes] */
+  uint64_t *time;
+  uint8_t *column[RING_CACHE_MAX_COLUMNS];
+  uint64_t reserved;                          /*!< rows written or being written */
+  uint64_t head;                              /*!< rows published */
+}s_ringCache;
+
+/**
+ * @brief Query result, valid until writer overwrites it (@ref ring_cache_valid)
+ */
+typedef struct{
+  uint64_t first;                             /*!< row number of first row */
+  uint64_t checked;                           /*!< lowest row read by query, search included */
+  size_t count;                               /*!< rows in slice */
+  size_t len[2];                              /*!< rows in first and second span */
+  const uint64_t *time[2];
+  const void *column[RING_CACHE_MAX_COLUMNS][2];
+}s_ringSlice;
+
+/**
+ * @brief Initialize cache over caller provided columns.
+ *
+ * @param[out]  cache         cache instance
+ * @param[in]   capacity      rows, power of 2
+ * @param[in]   time          time column (capacity entries)
+ * @param[in]   no_of_columns number of data columns
+ * @param[in]   size          element size of every data column [bytes]
+ * @param[in]   column        data columns (capacity elements each)
+ *
+ * @return false if capacity is not a power of 2 or there are too many columns
+ */
+bool ring_cache_init(s_ringCache *cache, uint32_t capacity, uint64_t *time, uint8_t no_of_columns,
+    const uint8_t *size, void *const *column);
+
+/**
+ * @brief Initialize cache of EEG channels (int16 columns).
+ */
+bool ring_cache_init_eeg(s_ringCache *cache, uint32_t capacity, uint64_t *time,
+    int16_t *const channel[RING_CACHE_EEG_COLUMNS]);
+
+/**
+ * @brief Initialize cache of pulse-oximeter and accelerometer samples.
+ */
+bool ring_cache_init_other(s_ringCache *cache, uint32_t capacity, uint64_t *time, int32_t *ir,
+    int32_t *red, int16_t *const acc[3]);
+
+/**
+ * @brief Append rows (writer thread only), the oldest rows are overwritten.
+ *
+ * @param[in,out] cache   cache instance
+ * @param[in]     time    row times, non-decreasing (e.g. host time from @ref clock_sync_convert)
+ * @param[in]     column  data columns in order given at init
+ * @param[in]     count   number of rows
+ */
+void ring_cache_append(s_ringCache *cache, const uint64_t *time, const void *const *column,
+    size_t count);
+
+/**
+ * @brief Append decoded EEG columns (@ref stream_decode_eeg).
+ */
+void ring_cache_append_eeg(s_ringCache *cache, const uint64_t *time, const s_eegColumns *eeg,
+    size_t count);
+
+/**
+ * @brief Append decoded pulse-oximeter/accelerometer columns (@ref stream_decode_other).
+ */
+void ring_cache_append_other(s_ringCache *cache, const uint64_t *time,
+    const s_otherColumns *other, size_t count);
+
+/**
+ * @brief Find rows with from <= time < to (any thread, never blocks writer).
+ *
+ * @param[in]   cache   cache instance
+ * @param[in]   from    range start
+ * @param[in]   to      range end
+ * @param[out]  slice   pointers to rows in the cache
+ *
+ * @return number of rows found
+ */
+size_t ring_cache_query(const s_ringCache *cache, uint64_t from, uint64_t to, s_ringSlice *slice);
+
+/**
+ * @brief Get the newest rows (e.g. last N minutes at known rate).
+ *
+ * @return number of rows found (less than count if cache holds fewer rows)
+ */
+size_t ring_cache_last(const s_ringCache *cache, size_t count, s_ringSlice *slice);
+
+/**
+ * @brief Check that slice was not overwritten; call after reading slice data.
+ *
+ * @return false if writer may have overwritten part of slice or rows searched by the query, data
+ *         read from it must be dropped
+ */
+bool ring_cache_valid(const s_ringCache *cache, const s_ringSlice *slice);
+
+/** @} */ //End of RING_CACHE
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_RING_CACHE_H */
@@ -0,0 +1,147 @@
+/**
+ * @file    ic_sketch.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Mergeable streaming statistics sketches for nightly summaries
+ *
+ * Fixed size summaries of streamed values (SpO2, band powers, movement, ...): Welford moments,
+ * t-digest quantiles and fixed range histogram counters. Every sketch is a plain structure without
+ * pointers, so it can be stored per device, copied between sessions or gateways as is (same
+ * endianness) and merged with the same kind of sketch at cost independent of number of values.
+ */
+
+#ifndef IC_SKETCH_H
+#define IC_SKETCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup SKETCH Streaming statistics sketches
+ *
+ * @{
+ */
+
+#define SKETCH_COMPRESSION    100   // t-digest compression, quantile error ~1/COMPRESSION at tails
+#define SKETCH_CENTROIDS      (SKETCH_COMPRESSION + 1)
+#define SKETCH_BUFFER         256   // values buffered before compression
+#define SKETCH_HISTOGRAM_BINS 64
+
+/**
+ * @brief Count, mean, variance and range (Welford)
+ */
+typedef struct{
+  uint64_t count;
+  double mean;
+  double m2;                /*!< sum of squared differences from mean */
+  float min;
+  float max;
+}s_sketchMoments;
+
+/**
+ * @brief t-digest centroid
+ */
+typedef struct{
+  double mean;
+  double weight;
+}s_sketchCentroid;
+
+/**
+ * @brief Quantile sketch (merging t-digest)
+ */
+typedef struct{
+  s_sketchCentroid centroid[SKETCH_CENTROIDS];  /*!< sorted by mean */
+  float buffer[SKETCH_BUFFER];                  /*!< values not compressed yet */
+  uint16_t no_of_centroids;
+  uint16_t no_of_buffered;
+  double weight;                                /*!< total weight of centroids */
+  float min;
+  float max;
+}s_sketchQuantiles;
+
+/**
+ * @brief Histogram counters of fixed range (e.g. movement per epoch, time in sleep stage)
+ */
+typedef struct{
+  float lo;
+  float hi;
+  uint32_t bin[SKETCH_HISTOGRAM_BINS];  /*!< bin i covers lo + i*(hi - lo)/BINS */
+  uint32_t under;                       /*!< values below lo */
+  uint32_t over;                        /*!< values at or above hi */
+}s_sketchHistogram;
+
+/**
+ * @brief Reset moments
+ */
+void sketch_moments_reset(s_sketchMoments *sketch);
+
+/**
+ * @brief Add values (NaN values are skipped).
+ */
+void sketch_moments_add(s_sketchMoments *sketch, const float *value, size_t count);
+
+/**
+ * @brief Merge src into dst (Chan et al. pairwise update).
+ */
+void sketch_moments_merge(s_sketchMoments *dst, const s_sketchMoments *src);
+
+/**
+ * @brief Sample variance, 0 for less than two values
+ */
+double sketch_moments_variance(const s_sketchMoments *sketch);
+
+/**
+ * @brief Reset quantile sketch
+ */
+void sketch_quantiles_reset(s_sketchQuantiles *sketch);
+
+/**
+ * @brief Add values (NaN values are skipped).
+ */
+void sketch_quantiles_add(s_sketchQuantiles *sketch, const float *value, size_t count);
+
+/**
+ * @brief Merge src into dst.
+ */
+void sketch_quantiles_merge(s_sketchQuantiles *dst, const s_sketchQuantiles *src);
+
+/**
+ * @brief Estimate quantile.
+ *
+ * @param[in,out] sketch  quantile sketch (buffered values are compressed first)
+ * @param[in]     q       quantile 0..1
+ *
+ * @return estimate, NaN if sketch is empty
+ */
+float sketch_quantiles_get(s_sketchQuantiles *sketch, float q);
+
+/**
+ * @brief Reset histogram of range lo..hi
+ *
+ * @return false if range is empty
+ */
+bool sketch_histogram_init(s_sketchHistogram *sketch, float lo, float hi);
+
+/**
+ * @brief Add values (NaN values are skipped).
+ */
+void sketch_histogram_add(s_sketchHistogram *sketch, const float *value, size_t count);
+
+/**
+ * @brief Merge src into dst.
+ *
+ * @return false if ranges differ (dst is not changed)
+ */
+bool sketch_histogram_merge(s_sketchHistogram *dst, const s_sketchHistogram *src);
+
+/** @} */ //End of SKETCH
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_SKETCH_H */
@@ -0,0 +1,156 @@
+/**
+ * @file    ic_sleep_events.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming sleep spindle and K-complex detector
+ *
+ * Filtered EEG (e.g. @ref eeg_filter_process output in uV) is split into sigma band and slow
+ * (K-complex) band by the EEG filter bank. Spindle: mean square of sigma band rises above multiple
+ * of its slow baseline and stays there for spindle duration; amplitude is peak-to-peak and
+ * frequency comes from zero crossings of sigma band. Next spindle may start after refractory
+ * period; sigma activity which outlasts maximal spindle duration is new background and becomes the
+ * baseline. K-complex: negative half-wave followed by positive one in slow band with large peak-to-
+ * peak, deep trough and typical duration. Memory per device is constant, events are reported as
+ * soon as they end.
+ */
+
+#ifndef IC_SLEEP_EVENTS_H
+#define IC_SLEEP_EVENTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_eeg_filter.h"
+
+/** @defgroup SLEEP_EVENTS Sleep spindle and K-complex detector
+ *
+ * @{
+ */
+
+/**
+ * @brief Event types
+ */
+typedef enum{
+  SLEEP_EVENT_SPINDLE = 0x00,
+  SLEEP_EVENT_K_COMPLEX
+}e_sleepEventType;
+
+/**
+ * @brief Detector specification (amplitudes in input unit, e.g. uV)
+ */
+typedef struct{
+  float sample_rate;        /*!< [Hz] */
+  float sigma_low;          /*!< sigma band [Hz] */
+  float sigma_high;
+  float spindle_start;      /*!< RMS/baseline RMS which starts spindle */
+  float spindle_end;        /*!< RMS/baseline RMS which ends spindle */
+  float spindle_min_p2p;    /*!< minimal spindle peak-to-peak */
+  float spindle_min;        /*!< spindle duration [s] */
+  float spindle_max;
+  float spindle_refractory; /*!< minimal time from end of spindle to start of next one [s] */
+  float kc_lowpass;         /*!< upper edge of K-complex band [Hz] */
+  float kc_min_p2p;         /*!< minimal K-complex peak-to-peak */
+  float kc_min_trough;      /*!< minimal depth of negative peak */
+  float kc_min;             /*!< K-complex duration [s] */
+  float kc_max;
+}s_sleepEventSpec;
+
+/**
+ * @brief Detector plan (shared, read only after @ref sleep_events_plan)
+ */
+typedef struct{
+  s_sleepEventSpec spec;
+  s_eegFilter sigma;
+  s_eegFilter slow;
+  float ms_alpha;           /*!< sigma mean square smoothing */
+  float base_alpha;         /*!< baseline smoothing */
+  float start2, end2;       /*!< squared thresholds */
+  uint32_t warm_up;         /*!< samples before baseline is trusted */
+  uint32_t spindle_min, spindle_max, spindle_refractory, kc_min, kc_max;  /*!< [samples] */
+}s_sleepEventPlan;
+
+/**
+ * @brief Detector state of one device
+ */
+typedef struct{
+  s_eegFilterState sigma;
+  s_eegFilterState slow;
+  uint64_t now;                       /*!< samples processed */
+
+  float ms[EEG_CHANNELS];             /*!< sigma band mean square */
+  float base[EEG_CHANNELS];           /*!< sigma band baseline mean square */
+  float sigma_last[EEG_CHANNELS];
+  bool spindle[EEG_CHANNELS];
+  uint64_t spindle_at[EEG_CHANNELS];
+  uint64_t armed_at[EEG_CHANNELS];    /*!< end of refractory period */
+  float spindle_lo[EEG_CHANNELS], spindle_hi[EEG_CHANNELS];
+  uint16_t crossings[EEG_CHANNELS];
+  float spindle_sum[EEG_CHANNELS];    /*!< sum of squared sigma band samples of spindle */
+
+  float slow_last[EEG_CHANNELS];
+  uint64_t fall_at[EEG_CHANNELS];     /*!< start of negative half-wave */
+  uint64_t rise_at[EEG_CHANNELS];     /*!< start of positive half-wave */
+  float trough[EEG_CHANNELS], peak[EEG_CHANNELS];
+  uint32_t dropped;                   /*!< events which did not fit in output */
+}s_sleepEventState;
+
+/**
+ * @brief Detected event
+ */
+typedef struct{
+  e_sleepEventType type;
+  uint8_t channel;
+  uint64_t start;           /*!< first sample of event (counted from reset) */
+  float duration;           /*!< [s] */
+  float amplitude;          /*!< peak-to-peak */
+  float frequency;          /*!< [Hz] */
+}s_sleepEvent;
+
+/**
+ * @brief Default specification (AASM-like): 11-16 Hz spindles of 0.5-3 s at least 1 s apart,
+ * K-complexes of 0.5-1.5 s and at least 75 uV
+ *
+ * @param[out]  spec        specification
+ * @param[in]   sample_rate [Hz]
+ */
+void sleep_events_default_spec(s_sleepEventSpec *spec, float sample_rate);
+
+/**
+ * @brief Prepare plan.
+ *
+ * @return false if bands are out of range or refractory period is negative
+ */
+bool sleep_events_plan(s_sleepEventPlan *plan, const s_sleepEventSpec *spec);
+
+/**
+ * @brief Reset device state (e.g. after gap in stream)
+ */
+void sleep_events_reset(s_sleepEventState *state);
+
+/**
+ * @brief Process filtered EEG samples of all channels.
+ *
+ * @param[in]     plan        detector plan
+ * @param[in,out] state       device state
+ * @param[in]     channel     channel columns
+ * @param[in]     count       number of samples in every column
+ * @param[out]    event       detected events
+ * @param[in]     max_events  room in event, further events are counted as dropped
+ *
+ * @return number of events
+ */
+size_t sleep_events_process(const s_sleepEventPlan *plan, s_sleepEventState *state,
+    const float *const channel[EEG_CHANNELS], size_t count, s_sleepEvent *event,
+    size_t max_events);
+
+/** @} */ //End of SLEEP_EVENTS
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_SLEEP_EVENTS_H */
@@ -0,0 +1,184 @@
+/**
+ * @file    ic_sleep_stage.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Sleep stage classifier over streamed epoch features
+ *
+ * Band powers (@ref band_power_process) and quality epochs (@ref eeg_quality_process) are
+ * accumulated during scoring epoch; at the end of epoch, together with actigraphy epoch
+ * (@ref actigraphy_process), they give feature vector which is scored by gradient boosted trees
+ * supplied by caller as static tables (@ref s_sleepModel). Channels flagged bad in most of the
+ * epoch are excluded. Stager state is small and classification costs a few dozen comparisons, so
+ * hypnogram of hundreds of masks is built incrementally on one core.
+ *
+ * Library ships no trained model. Hand-set placeholder trees (@ref sleep_stage_placeholder) are
+ * compiled only with IC_SLEEP_STAGE_PLACEHOLDER defined (CMake option
+ * NUC_SLEEP_STAGE_PLACEHOLDER); they are not validated against polysomnography and are meant for
+ * exercising the pipeline during development only.
+ *
+ * Example model (every tree adds its leaf value to score of its stage):
+ * @code
+ *  static const s_sleepTree trees[] = {
+ *    SLEEP_TREE(SLEEP_STAGE_N3, SLEEP_NODE(REL_DELTA, 0.5f, 1, 2), SLEEP_LEAF(-1), SLEEP_LEAF(1)),
+ *    SLEEP_TREE(SLEEP_STAGE_WAKE, SLEEP_NODE(TAT, 5, 1, 2), SLEEP_LEAF(-0.5f), SLEEP_LEAF(1)),
+ *  };
+ *  static const s_sleepModel model = {trees, sizeof(trees)/sizeof(trees[0])};
+ * @endcode
+ */
+
+#ifndef IC_SLEEP_STAGE_H
+#define IC_SLEEP_STAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_actigraphy.h"
+#include "ic_band_power.h"
+#include "ic_eeg_quality.h"
+
+/** @defgroup SLEEP_STAGE Sleep stage classifier
+ *
+ * @{
+ */
+
+/**
+ * @brief Sleep stages
+ */
+typedef enum{
+  SLEEP_STAGE_UNKNOWN = 0x00,   /*!< no good EEG channel in epoch */
+  SLEEP_STAGE_WAKE,
+  SLEEP_STAGE_REM,
+  SLEEP_STAGE_N1,
+  SLEEP_STAGE_N2,
+  SLEEP_STAGE_N3,
+  SLEEP_STAGES
+}e_sleepStage;
+
+/**
+ * @brief Model features
+ */
+typedef enum{
+  SLEEP_FEATURE_LOG_POWER = 0x00, /*!< log10 of total power [uV^2] */
+  SLEEP_FEATURE_REL_DELTA,        /*!< band power/total power */
+  SLEEP_FEATURE_REL_THETA,
+  SLEEP_FEATURE_REL_ALPHA,
+  SLEEP_FEATURE_REL_SIGMA,
+  SLEEP_FEATURE_REL_BETA,
+  SLEEP_FEATURE_LOG_PIM,          /*!< log10(1 + PIM [mg*s]) */
+  SLEEP_FEATURE_TAT,              /*!< time above threshold [s] */
+  SLEEP_FEATURES
+}e_sleepFeature;
+
+#define SLEEP_NODE_LEAF   -1      // feature of leaf node
+
+/**
+ * @brief Tree node; internal node sends x[feature] < value to left child, otherwise to right
+ */
+typedef struct{
+  int8_t feature;         /*!< @ref e_sleepFeature or @ref SLEEP_NODE_LEAF */
+  uint8_t left;           /*!< child node index, must be greater than index of this node */
+  uint8_t right;
+  float value;            /*!< threshold or leaf score */
+}s_sleepTreeNode;
+
+/**
+ * @brief Flat node table of one tree, root is node 0
+ */
+typedef struct{
+  e_sleepStage stage;               /*!< stage whose score the tree adds to */
+  uint8_t nodes;
+  const s_sleepTreeNode *node;
+}s_sleepTree;
+
+/**
+ * @brief Boosted tree ensemble (layout exported by common GBT trainers for multi-class problems)
+ */
+typedef struct{
+  const s_sleepTree *tree;
+  size_t trees;
+}s_sleepModel;
+
+/** Internal node of static tree table, e.g. SLEEP_NODE(REL_DELTA, 0.5f, 1, 2) */
+#define SLEEP_NODE(f, thr, l, r)  {SLEEP_FEATURE_##f, l, r, thr}
+/** Leaf of static tree table */
+#define SLEEP_LEAF(v)             {SLEEP_NODE_LEAF, 0, 0, v}
+/** Static tree of given stage from node list, root first */
+#define SLEEP_TREE(stage, ...)    {stage,\
+  sizeof((s_sleepTreeNode[]){__VA_ARGS__})/sizeof(s_sleepTreeNode),\
+  (const s_sleepTreeNode[]){__VA_ARGS__}}
+
+#ifdef IC_SLEEP_STAGE_PLACEHOLDER
+/**
+ * @brief Hand-set placeholder model, NOT trained (textbook band ratios and movement).
+ */
+extern const s_sleepModel sleep_stage_placeholder;
+#endif
+
+/**
+ * @brief Stager state of one device
+ */
+typedef struct{
+  const s_sleepModel *model;
+  float power[EEG_BANDS][EEG_CHANNELS]; /*!< band power sums of epoch */
+  uint32_t hops;
+  uint16_t bad[EEG_CHANNELS];           /*!< bad quality epochs of channel */
+  uint16_t quality_epochs;
+  e_sleepStage previous;
+  uint32_t index;
+}s_sleepStager;
+
+/**
+ * @brief Scored epoch
+ */
+typedef struct{
+  uint32_t index;                 /*!< scoring epoch number since init */
+  e_sleepStage stage;
+  float confidence;               /*!< probability of stage (softmax of tree scores) */
+  uint8_t channels;               /*!< bitmask of channels used */
+  float feature[SLEEP_FEATURES];
+}s_sleepEpoch;
+
+/**
+ * @brief Initialize stager.
+ *
+ * @param[out]  stager  stager state
+ * @param[in]   model   tree ensemble, must stay valid while stager is used
+ *
+ * @return false if model has no trees or a tree has unknown stage or feature, or child index
+ * that does not point forward inside its table
+ */
+bool sleep_stage_init(s_sleepStager *stager, const s_sleepModel *model);
+
+/**
+ * @brief Accumulate band power outputs of current epoch.
+ */
+void sleep_stage_add_band_power(s_sleepStager *stager, const s_bandPower *power, size_t count);
+
+/**
+ * @brief Accumulate quality epochs of current epoch.
+ */
+void sleep_stage_add_quality(s_sleepStager *stager, const s_eegQuality *quality, size_t count);
+
+/**
+ * @brief Score epoch from accumulated features and start next one.
+ *
+ * @param[in,out] stager    stager state
+ * @param[in]     activity  actigraphy of the epoch, may be NULL if not available
+ * @param[out]    out       scored epoch, may be NULL
+ *
+ * @return sleep stage
+ */
+e_sleepStage sleep_stage_epoch(s_sleepStager *stager, const s_actigraphyEpoch *activity,
+    s_sleepEpoch *out);
+
+/** @} */ //End of SLEEP_STAGE
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_SLEEP_STAGE_H */
@@ -0,0 +1,124 @@
+/**
+ * @file    ic_spo2.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming SpO2 and heart rate estimation from AFE4400 IR/red samples
+ *
+ * Every sample: DC of both channels is tracked by slow exponential average, pulsatile (AC) part
+ * is smoothed and beats are detected on IR channel with adaptive threshold and refractory period.
+ * Every beat gives interval and ratio of ratios R = (AC_red/DC_red)/(AC_ir/DC_ir); heart rate and
+ * SpO2 = cal_a - cal_b*R are medians of last @ref SPO2_BEATS beats. State has fixed size and is
+ * updated per batch of decoded samples (@ref stream_decode_other), so one core serves many masks.
+ */
+
+#ifndef IC_SPO2_H
+#define IC_SPO2_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup SPO2 SpO2 and heart rate estimation
+ *
+ * @{
+ */
+
+#define SPO2_BEATS  5   // beats in median
+
+/**
+ * @brief Quality flags (0 - estimates are valid)
+ */
+#define SPO2_QUALITY_NO_CONTACT     0x01  // DC too low or ADC saturated
+#define SPO2_QUALITY_LOW_PERFUSION  0x02  // pulsatile part too small
+#define SPO2_QUALITY_NO_PULSE       0x04  // no beat detected recently
+#define SPO2_QUALITY_IRREGULAR      0x08  // beat intervals differ too much
+#define SPO2_QUALITY_SETTLING       0x10  // not enough beats since start
+
+/**
+ * @brief Estimator configuration
+ */
+typedef struct{
+  float sample_rate;      /*!< [Hz] */
+  float cal_a;            /*!< SpO2 = cal_a - cal_b*R [%] */
+  float cal_b;
+  float min_dc;           /*!< lower DC means no contact [ADC units] */
+  float min_perfusion;    /*!< minimal AC/DC of IR channel */
+}s_spo2Config;
+
+/**
+ * @brief Estimates
+ */
+typedef struct{
+  float spo2;             /*!< [%] */
+  float heart_rate;       /*!< [bpm] */
+  float perfusion;        /*!< AC/DC of IR channel of last beat [%] */
+  uint8_t quality;        /*!< SPO2_QUALITY_* flags */
+  uint32_t beats;         /*!< beats detected since start */
+}s_spo2Result;
+
+/**
+ * @brief Estimator state of one device
+ */
+typedef struct{
+  s_spo2Config config;
+  float dc_alpha;         /*!< DC tracking coefficient */
+  float ac_alpha;         /*!< AC smoothing coefficient */
+  uint32_t refractory;    /*!< minimal beat interval [samples] */
+  uint32_t max_interval;  /*!< maximal beat interval [samples] */
+
+  float dc_ir, dc_red;
+  float ir1, ir2, red1, red2;                 /*!< AC smoothing stages */
+  float seg_max, seg_min, red_max, red_min;   /*!< extremes since last beat */
+  uint32_t seg_max_at;
+  uint32_t now;                               /*!< samples processed */
+  uint32_t last_beat;
+  float amplitude;                            /*!< running IR beat amplitude */
+
+  float interval[SPO2_BEATS];
+  float ratio[SPO2_BEATS];
+  float median_interval;                      /*!< [samples] */
+  uint8_t no_of_beats;                        /*!< valid entries in interval/ratio */
+  uint8_t next;
+  bool saturated;
+  s_spo2Result result;
+}s_spo2State;
+
+/**
+ * @brief Default configuration (empirical calibration 110 - 25*R)
+ *
+ * @param[out]  config      configuration
+ * @param[in]   sample_rate AFE4400 sample rate [Hz]
+ */
+void spo2_default_config(s_spo2Config *config, float sample_rate);
+
+/**
+ * @brief Initialize estimator
+ *
+ * @param[out]  state   estimator state
+ * @param[in]   config  configuration
+ */
+void spo2_init(s_spo2State *state, const s_spo2Config *config);
+
+/**
+ * @brief Process batch of IR/red samples and update estimates.
+ *
+ * @param[in,out] state   estimator state
+ * @param[in]     ir      IR samples
+ * @param[in]     red     red samples
+ * @param[in]     count   number of samples
+ * @param[out]    result  estimates after batch, may be NULL
+ */
+void spo2_process(s_spo2State *state, const int32_t *ir, const int32_t *red, size_t count,
+    s_spo2Result *result);
+
+/** @} */ //End of SPO2
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_SPO2_H */
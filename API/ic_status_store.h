@@ -0,0 +1,125 @@
+/**
+ * @file    ic_status_store.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Device status store
+ *
+ * Keeps last status (@ref s_statusRsp) of a mask. Receiving thread publishes decoded status,
+ * any number of other threads take consistent snapshots without locking (sequence lock - readers
+ * retry if they raced with a writer).
+ */
+
+#ifndef IC_STATUS_STORE_H
+#define IC_STATUS_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_low_level_control.h"
+
+/** @defgroup STATUS_STORE device status store
+ *  @ingroup STATUS_CONTROL
+ *  @{
+ */
+
+///Change mask bit of active data streams, bits 0-7 are device bits (@ref e_deviceType)
+#define STATUS_CHANGE_DATA_STREAMS 0x0100
+
+/**
+ * @brief Decoded mask status
+ */
+typedef struct{
+  uint16_t id;                  /*!< id of status response */
+  s_devsFunc devs_func;         /*!< current devices functions */
+  uint8_t active_data_streams;  /*!< data streams bits, the same as in @ref status_rsp_gen_func */
+}s_statusSnapshot;
+
+/**
+ * @brief Change notification
+ *
+ * Called by publishing thread, after new status is visible to readers. Not called if only id of
+ * status response changed.
+ *
+ * @param[in] prev    status before change
+ * @param[in] curr    status after change
+ * @param[in] changed device bits (@ref e_deviceType) of changed functions and @ref
+ *                    STATUS_CHANGE_DATA_STREAMS
+ * @param[in] user    user data given in @ref status_store_init
+ */
+typedef void (*f_statusChange)(const s_statusSnapshot *prev, const s_statusSnapshot *curr,
+    uint16_t changed, void *user);
+
+#define STATUS_STORE_WORDS ((sizeof(s_statusSnapshot)+3)/4)
+
+/**
+ * @brief Status store, one per mask.
+ *
+ * Fields must not be accessed directly.
+ */
+typedef struct{
+  uint32_t seq;
+  uint32_t data[STATUS_STORE_WORDS];
+  f_statusChange on_change;
+  void *user;
+}s_statusStore;
+
+/**
+ * @brief Initialize store, before first publish all functions are FUN_TYPE_OFF.
+ *
+ * @param[out]  store     store instance
+ * @param[in]   on_change change notification, may be NULL
+ * @param[in]   user      user data passed to on_change
+ */
+void status_store_init(s_statusStore *store, f_statusChange on_change, void *user);
+
+/**
+ * @brief Publish status
+ *
+ * @param[in,out] store               store instance
+ * @param[in]     devs_func           devices functions
+ * @param[in]     active_data_streams data streams bits
+ * @param[in]     id                  id of status response
+ *
+ * @return device and data streams change mask (0 if nothing but id changed)
+ */
+uint16_t status_store_publish(s_statusStore *store, s_devsFunc devs_func,
+    uint8_t active_data_streams, uint16_t id);
+
+/**
+ * @brief Decode status response frame and publish it
+ *
+ * @param[in,out] store     store instance
+ * @param[in]     rsp_frame 20 bytes status response frame
+ *
+ * @return false if frame is not valid status response
+ */
+bool status_store_publish_frame(s_statusStore *store, char *rsp_frame);
+
+/**
+ * @brief Take consistent copy of status. Never blocks writer.
+ *
+ * @param[in]   store     store instance
+ * @param[out]  snapshot  status copy
+ *
+ * @return version of the copy, it grows with every publish
+ */
+uint32_t status_store_snapshot(const s_statusStore *store, s_statusSnapshot *snapshot);
+
+/**
+ * @brief Current version - cheap check if snapshot is still up to date
+ *
+ * @param[in] store store instance
+ */
+uint32_t status_store_version(const s_statusStore *store);
+
+/** @} */ //End of STATUS_STORE
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_STATUS_STORE_H */
@@ -0,0 +1,169 @@
+/**
+ * @file    ic_stimulation.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Closed-loop stimulation fast path (slow oscillation phase to light/vibration frames)
+ *
+ * EEG of one channel is band-passed to slow oscillation band; zero crossings of the result give
+ * phase and frequency of the oscillation (phase lag of the band-pass at the estimated frequency is
+ * compensated). Phase convention: 0 - rising zero crossing, pi/2 - up-state peak, 3*pi/2 -
+ * down-state trough. At the end of every batch time to target phase is predicted and if waiting for
+ * the next batch (expected after the mean interval between batches) would be later than sending
+ * now (minus configured lead), the stimulus frame is sent directly through transport. Frame is
+ * built when stimulus is prepared; firing only stamps the next id of the reserved id range and its
+ * CRC before one send call. Decision latency (frame reception to send) is measured with
+ * user clock.
+ */
+
+#ifndef IC_STIMULATION_H
+#define IC_STIMULATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_async.h"
+#include "ic_low_level_control.h"
+
+/** @defgroup STIMULATION Closed-loop stimulation
+ *
+ * @{
+ */
+
+#define STIM_SECTIONS     2   // band-pass: second order high-pass + second order low-pass
+
+/**
+ * @brief Host clock [us]
+ */
+typedef uint64_t (*f_stimClock)(void *user);
+
+/**
+ * @brief Stimulator configuration
+ */
+typedef struct{
+  float sample_rate;        /*!< [Hz] */
+  float low;                /*!< band-pass edges [Hz] */
+  float high;
+  float target_phase;       /*!< [rad], 0..2*pi */
+  float lead_us;            /*!< transmission and mask reaction time */
+  float min_amplitude;      /*!< minimal peak-to-trough of oscillation [input unit] */
+  uint32_t refractory_us;   /*!< minimal time between stimuli */
+}s_stimConfig;
+
+/**
+ * @brief Stimulator statistics
+ */
+typedef struct{
+  uint32_t fired;
+  uint32_t send_failed;
+  uint64_t last_latency_us;   /*!< frame reception to send of last stimulus */
+  uint64_t max_latency_us;
+  uint64_t sum_latency_us;
+}s_stimStats;
+
+/**
+ * @brief Stimulator of one device
+ */
+typedef struct{
+  s_stimConfig config;
+  float b0[STIM_SECTIONS], b1[STIM_SECTIONS], b2[STIM_SECTIONS];
+  float a1[STIM_SECTIONS], a2[STIM_SECTIONS];
+  float z1[STIM_SECTIONS], z2[STIM_SECTIONS];
+  float min_period, max_period;   /*!< [samples] */
+
+  uint32_t now;                   /*!< samples processed */
+  float last;                     /*!< last filtered sample */
+  uint32_t rise_at, fall_at;      /*!< last zero crossings */
+  float peak, trough;             /*!< extremes of current half-waves */
+  float amplitude;                /*!< peak-to-trough of last cycle */
+  float period;                   /*!< [samples], 0 - unknown */
+  float lag;                      /*!< band-pass phase lag at 2*pi/period [rad] */
+  bool armed;                     /*!< stimulus allowed in current cycle */
+  uint32_t last_fired;
+  uint64_t last_rx_us;            /*!< reception time of previous batch */
+  float batch_us;                 /*!< mean interval between batches, 0 - unknown */
+
+  char frame[NUC_FRAME_SIZE];
+  size_t len;
+  int uuid;                       /*!< ERROR_UUID if no stimulus is prepared */
+  uint16_t first_id;              /*!< reserved command ids first_id..first_id+no_of_ids-1 */
+  uint16_t no_of_ids;
+  uint16_t next_id;               /*!< offset of id of the next stimulus in reserved range */
+
+  s_asyncTransport *transport;
+  f_stimClock clock;
+  void *clock_user;
+  s_stimStats stats;
+}s_stimulator;
+
+/**
+ * @brief Default configuration: 0.5-2 Hz band, up-state target, 75 uV minimal amplitude
+ *
+ * @param[out]  config      configuration
+ * @param[in]   sample_rate EEG sample rate [Hz]
+ */
+void stim_default_config(s_stimConfig *config, float sample_rate);
+
+/**
+ * @brief Initialize stimulator.
+ *
+ * @param[out]  stim        stimulator
+ * @param[in]   config      configuration
+ * @param[in]   transport   transport of the mask
+ * @param[in]   clock       host clock, used for latency measurement
+ * @param[in]   clock_user  clock user data
+ *
+ * @return false if configuration is invalid
+ */
+bool stim_init(s_stimulator *stim, const s_stimConfig *config, s_asyncTransport *transport,
+    f_stimClock clock, void *clock_user);
+
+/**
+ * @brief Pre-build light stimulus (@ref rgb_led_set_func).
+ *
+ * Stimuli are sent past async loop, so their responses must not match requests of the loop:
+ * ids first_id..first_id+no_of_ids-1 are reserved for the stimulator and must not be used for
+ * other commands of the mask. Ids are used in turn, so an id is reused only after no_of_ids
+ * stimuli, i.e. no sooner than no_of_ids refractory periods.
+ *
+ * @return false if frame could not be built or no_of_ids is 0
+ */
+bool stim_prepare_light(s_stimulator *stim, e_rgbLedSide side, e_funcType func,
+    e_rgbLedColor color, uint8_t intensity, uint32_t duration, uint16_t period, uint16_t first_id,
+    uint16_t no_of_ids);
+
+/**
+ * @brief Pre-build vibration stimulus (@ref vibrator_set_func), ids as in @ref stim_prepare_light.
+ *
+ * @return false if frame could not be built or no_of_ids is 0
+ */
+bool stim_prepare_vibration(s_stimulator *stim, e_funcType func, uint8_t intensity,
+    uint32_t duration, uint16_t period, uint16_t first_id, uint16_t no_of_ids);
+
+/**
+ * @brief Process batch of EEG samples and fire stimulus if target phase is due.
+ *
+ * @param[in,out] stim    stimulator
+ * @param[in]     sample  EEG samples, the last one is the newest
+ * @param[in]     count   number of samples
+ * @param[in]     rx_us   host time of reception of the newest sample (same clock as stim_init)
+ *
+ * @return true if stimulus was sent
+ */
+bool stim_process(s_stimulator *stim, const float *sample, size_t count, uint64_t rx_us);
+
+/**
+ * @brief Current phase estimate [rad], negative if no oscillation is tracked.
+ */
+float stim_phase(const s_stimulator *stim);
+
+/** @} */ //End of STIMULATION
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_STIMULATION_H */
@@ -0,0 +1,110 @@
+/**
+ * @file    ic_stream_decoder.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Batch decoder of data stream frames
+ *
+ * Transposes runs of data frames (array of frame containers, as received) into per-channel
+ * columns (structure of arrays). Decoding uses vector shuffles where compiler supports them and
+ * gives bit-exact results of reading frame containers one by one.
+ *
+ * Columns are caller-owned. Any alignment works, columns aligned to @ref STREAM_DECODER_ALIGN
+ * bytes avoid vector stores split across cache lines.
+ */
+
+#ifndef IC_STREAM_DECODER_H
+#define IC_STREAM_DECODER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ic_frame_handle.h"
+
+/** @defgroup STREAM_DECODER data stream batch decoder
+ *
+ * @{
+ */
+
+#define EEG_CHANNELS          8   // samples in one EEG frame
+#define STREAM_DECODER_ALIGN  32  // recommended column alignment
+
+/**
+ * @brief Raw EEG columns
+ */
+typedef struct{
+  uint32_t *time_stamp;               /*!< may be NULL if time stamps are not needed */
+  int16_t *channel[EEG_CHANNELS];     /*!< sample i of frame n is stored in channel[i][n] */
+}s_eegColumns;
+
+/**
+ * @brief EEG columns in microvolts
+ */
+typedef struct{
+  uint32_t *time_stamp;               /*!< may be NULL if time stamps are not needed */
+  float *channel[EEG_CHANNELS];
+}s_eegColumnsUv;
+
+/**
+ * @brief Conversion to microvolts: uV = raw*gain + offset
+ */
+typedef struct{
+  float gain[EEG_CHANNELS];           /*!< [uV/LSB] */
+  float offset[EEG_CHANNELS];         /*!< [uV] */
+}s_eegScale;
+
+/**
+ * @brief Pulse-oximeter, accelerometer and temperature columns
+ *
+ * Any column may be NULL if it is not needed.
+ */
+typedef struct{
+  uint32_t *time_stamp;
+  int32_t *ir;
+  int32_t *red;
+  int16_t *acc_x;
+  int16_t *acc_y;
+  int16_t *acc_z;
+  int8_t *temp[2];                    /*!< temp[0] and temp[1] bytes of frame */
+}s_otherColumns;
+
+/**
+ * @brief Decode EEG frames into channel columns.
+ *
+ * @param[in]   frames  received EEG frames
+ * @param[in]   count   number of frames
+ * @param[out]  out     columns, each with room for count entries
+ */
+void stream_decode_eeg(const u_eegDataFrameContainter *frames, size_t count,
+    const s_eegColumns *out);
+
+/**
+ * @brief Decode EEG frames into channel columns converted to microvolts.
+ *
+ * @param[in]   frames  received EEG frames
+ * @param[in]   count   number of frames
+ * @param[in]   scale   per channel gain and offset
+ * @param[out]  out     columns, each with room for count entries
+ */
+void stream_decode_eeg_uv(const u_eegDataFrameContainter *frames, size_t count,
+    const s_eegScale *scale, const s_eegColumnsUv *out);
+
+/**
+ * @brief Decode pulse-oximeter/accelerometer/temperature frames into columns.
+ *
+ * @param[in]   frames  received frames
+ * @param[in]   count   number of frames
+ * @param[out]  out     columns, each with room for count entries
+ */
+void stream_decode_other(const u_otherDataFrameContainer *frames, size_t count,
+    const s_otherColumns *out);
+
+/** @} */ //End of STREAM_DECODER
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_STREAM_DECODER_H */
@@ -0,0 +1,135 @@
+/**
+ * @file    ic_stream_merge.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming merge of data streams onto common time base
+ *
+ * Joins decoded streams of different rates (EEG from DATA_STREAM0, pulse-oximeter, accelerometer
+ * and temperature from DATA_STREAM1) into multi-channel records at fixed output rate. Record for
+ * time t is emitted as soon as any input has data newer than t + latency, so output latency is
+ * fixed. Every input keeps only last @ref STREAM_MERGE_DEPTH samples - memory does not grow with
+ * recording length.
+ */
+
+#ifndef IC_STREAM_MERGE_H
+#define IC_STREAM_MERGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup STREAM_MERGE data streams merge
+ *
+ * @{
+ */
+
+#define STREAM_MERGE_MAX_INPUTS   4
+#define STREAM_MERGE_MAX_CHANNELS 8     // per input
+#define STREAM_MERGE_DEPTH        256   // samples kept per input, power of 2; has to cover latency
+
+/**
+ * @brief Interpolation of input values at record time
+ */
+typedef enum{
+  MERGE_HOLD = 0x00,    /*!< last sample not newer than record time */
+  MERGE_NEAREST,        /*!< sample nearest to record time */
+  MERGE_LINEAR          /*!< linear interpolation between neighbouring samples */
+}e_mergeInterp;
+
+/**
+ * @brief Merge configuration
+ */
+typedef struct{
+  int64_t period_us;      /*!< output record period */
+  int64_t latency_us;     /*!< output latency behind newest input data */
+  int64_t stale_us;       /*!< neighbouring samples further apart make value stale */
+  e_mergeInterp interp;
+}s_streamMergeConfig;
+
+/**
+ * @brief Output record
+ */
+typedef struct{
+  int64_t time_us;
+  uint32_t stale;         /*!< bit i set if value of input i is held or extrapolated over gap */
+  float value[STREAM_MERGE_MAX_INPUTS*STREAM_MERGE_MAX_CHANNELS];  /*!< inputs in order */
+}s_mergeRecord;
+
+/**
+ * @brief Input of merge
+ */
+typedef struct{
+  uint8_t channels;
+  uint32_t head;          /*!< samples pushed */
+  uint32_t cursor;        /*!< last sample not newer than next record */
+  int64_t time[STREAM_MERGE_DEPTH];
+  float value[STREAM_MERGE_DEPTH][STREAM_MERGE_MAX_CHANNELS];
+}s_mergeInput;
+
+/**
+ * @brief Merge instance
+ */
+typedef struct{
+  s_streamMergeConfig config;
+  s_mergeInput input[STREAM_MERGE_MAX_INPUTS];
+  uint8_t no_of_inputs;
+  uint8_t channels;       /*!< channels in record */
+  bool started;
+  int64_t next_us;        /*!< time of next record */
+  int64_t horizon_us;     /*!< newest input time */
+  uint64_t late;          /*!< samples dropped because older than last sample of input */
+  uint64_t overruns;      /*!< samples overwritten before use (depth too small for latency) */
+}s_streamMerge;
+
+/**
+ * @brief Initialize merge
+ *
+ * @param[out]  merge   merge instance
+ * @param[in]   config  merge configuration
+ */
+void stream_merge_init(s_streamMerge *merge, const s_streamMergeConfig *config);
+
+/**
+ * @brief Add input, its channels follow channels of previously added inputs in records.
+ *
+ * @param[in,out] merge     merge instance
+ * @param[in]     channels  number of channels
+ *
+ * @return input index or -1 if there is no room
+ */
+int stream_merge_add_input(s_streamMerge *merge, uint8_t channels);
+
+/**
+ * @brief Push decoded samples of input.
+ *
+ * @param[in,out] merge   merge instance
+ * @param[in]     input   input index
+ * @param[in]     time_us host time of samples (@ref clock_sync_convert)
+ * @param[in]     column  channel columns (e.g. s_eegColumnsUv.channel)
+ * @param[in]     count   number of samples
+ */
+void stream_merge_push(s_streamMerge *merge, int input, const int64_t *time_us,
+    const float *const *column, size_t count);
+
+/**
+ * @brief Get records which are ready.
+ *
+ * @param[in,out] merge   merge instance
+ * @param[out]    record  records
+ * @param[in]     max     capacity of record
+ *
+ * @return number of records
+ */
+size_t stream_merge_pull(s_streamMerge *merge, s_mergeRecord *record, size_t max);
+
+/** @} */ //End of STREAM_MERGE
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_STREAM_MERGE_H */
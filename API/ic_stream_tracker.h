@@ -0,0 +1,116 @@
+/**
+ * @file    ic_stream_tracker.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Time stamp unwrapping, gap and duplicate detection for data streams
+ *
+ * One tracker per data stream of every mask. Tracker lifts 32 bit frame time stamps to monotonic
+ * 64 bit values, drops duplicated and late (older than last accepted) frames and reports gaps
+ * with number of lost frames and samples. A run of @ref STREAM_TRACKER_RESYNC consecutive late
+ * frames is taken as forward jump of time stamps by half of the range or more (e.g. device clock
+ * reset) and the tracker resynchronizes to the new time base. Batches are processed in one pass
+ * over time stamp column (see @ref stream_decode_eeg), statistics are plain counters.
+ */
+
+#ifndef IC_STREAM_TRACKER_H
+#define IC_STREAM_TRACKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup STREAM_TRACKER data stream tracker
+ *
+ * @{
+ */
+
+#define STREAM_TRACKER_RESYNC 16  ///< consecutive late frames after which tracker resynchronizes
+
+/**
+ * @brief Stream statistics
+ */
+typedef struct{
+  uint64_t frames;        /*!< frames processed */
+  uint64_t accepted;      /*!< frames passed on */
+  uint64_t duplicates;    /*!< frames with time stamp equal to last accepted */
+  uint64_t late;          /*!< frames older than last accepted */
+  uint64_t gaps;          /*!< number of gaps */
+  uint64_t lost_frames;   /*!< frames missing in gaps */
+  uint64_t resyncs;       /*!< jumps to new time base */
+}s_streamStats;
+
+/**
+ * @brief Gap before accepted frame
+ */
+typedef struct{
+  size_t index;           /*!< index (in output) of first frame after gap */
+  uint64_t time_stamp;    /*!< unwrapped time stamp of that frame */
+  uint32_t lost_frames;
+  uint64_t lost_samples;
+}s_streamGap;
+
+/**
+ * @brief Tracker of one stream
+ */
+typedef struct{
+  uint32_t step;              /*!< nominal time stamp increment between frames, 0 if unknown */
+  uint32_t tolerance;         /*!< allowed deviation from step before gap is reported */
+  uint32_t samples_per_frame;
+  bool started;
+  uint32_t last;              /*!< last accepted raw time stamp */
+  uint64_t last_unwrapped;
+  uint32_t late_run;          /*!< consecutive late frames */
+  s_streamStats stats;
+}s_streamTracker;
+
+/**
+ * @brief Initialize tracker (also when stream is restarted after reconnection).
+ *
+ * @param[out]  tracker           tracker instance
+ * @param[in]   step              nominal time stamp increment between frames, 0 disables gap
+ *                                detection
+ * @param[in]   tolerance         jitter of time stamp increment which is not a gap
+ * @param[in]   samples_per_frame samples of one channel carried by frame
+ */
+void stream_tracker_init(s_streamTracker *tracker, uint32_t step, uint32_t tolerance,
+    uint32_t samples_per_frame);
+
+/**
+ * @brief Process batch of frame time stamps.
+ *
+ * Output arrays are compacted - duplicated and late frames are skipped. Frame which completes
+ * run of @ref STREAM_TRACKER_RESYNC late frames is accepted without gap, its unwrapped time stamp
+ * moves forward by raw difference modulo 2^32.
+ *
+ * @param[in,out] tracker     tracker instance
+ * @param[in]     time_stamp  raw time stamps of received frames
+ * @param[in]     count       number of frames
+ * @param[out]    index       input index of every accepted frame (count entries), may be NULL
+ * @param[out]    unwrapped   64 bit time stamp of every accepted frame (count entries), may be NULL
+ * @param[out]    gaps        gaps found in batch, may be NULL
+ * @param[in]     max_gaps    capacity of gaps, further gaps are counted in statistics only
+ * @param[out]    no_gaps     number of gaps stored, may be NULL
+ *
+ * @return number of accepted frames
+ */
+size_t stream_tracker_process(s_streamTracker *tracker, const uint32_t *time_stamp, size_t count,
+    uint32_t *index, uint64_t *unwrapped, s_streamGap *gaps, size_t max_gaps, size_t *no_gaps);
+
+/**
+ * @brief Fraction of lost frames in permille
+ *
+ * @param[in] tracker tracker instance
+ */
+uint32_t stream_tracker_loss_permille(const s_streamTracker *tracker);
+
+/** @} */ //End of STREAM_TRACKER
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_STREAM_TRACKER_H */
@@ -0,0 +1,129 @@
+/**
+ * @file    ic_timer_wheel.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Hierarchical timing wheel
+ *
+ * Generic timer facility used by host side schedulers. Timers are intrusive nodes owned by the
+ * caller, so arming and cancelling never allocate and both take constant time. Time is counted
+ * in abstract ticks - resolution is chosen by the caller (e.g. ms or s).
+ */
+
+#ifndef IC_TIMER_WHEEL_H
+#define IC_TIMER_WHEEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @defgroup TIMER_WHEEL hierarchical timing wheel
+ *
+ * @{
+ */
+
+#define TIMER_WHEEL_LEVELS    4
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS     (1u<<TIMER_WHEEL_SLOT_BITS)
+
+/**
+ * @brief Timer node
+ *
+ * Embed it in own structure and use @ref TIMER_WHEEL_CONTAINER to get back to it in expire
+ * handler. Node has to be zeroed (or initialized with @ref timer_wheel_node_init) before first use.
+ */
+typedef struct s_twNode{
+  struct s_twNode *next;
+  struct s_twNode *prev;
+  uint64_t expires;   /*!< absolute tick in which timer expires */
+}s_twNode;
+
+/**
+ * @brief Timing wheel instance
+ *
+ * Four levels of 64 slots cover 2^24 ticks ahead of current tick. Timers which are set further
+ * are kept on overflow list and moved into the wheel when they come into range.
+ */
+typedef struct{
+  s_twNode slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+  s_twNode overflow;
+  uint64_t now;       /*!< next tick to be processed */
+  size_t pending;     /*!< number of timers in the wheel */
+}s_timerWheel;
+
+/**
+ * @brief Timer expiry handler
+ *
+ * Node is already removed from wheel when handler is called, so it may be added again.
+ */
+typedef void (*f_timerWheelExpire)(s_twNode *node, void *user);
+
+///Get pointer to structure containing timer node
+#define TIMER_WHEEL_CONTAINER(ptr, type, member) \
+  ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/**
+ * @brief Initialize timing wheel
+ *
+ * @param[out]  tw    wheel instance
+ * @param[in]   now   current tick
+ */
+void timer_wheel_init(s_timerWheel *tw, uint64_t now);
+
+/**
+ * @brief Initialize timer node
+ *
+ * @param[out]  node  timer node
+ */
+void timer_wheel_node_init(s_twNode *node);
+
+/**
+ * @brief Add timer (or move already pending one).
+ *
+ * Timers which expire in the past are fired on next @ref timer_wheel_advance call.
+ *
+ * @param[in,out] tw      wheel instance
+ * @param[in,out] node    timer node
+ * @param[in]     expires absolute tick of expiry
+ */
+void timer_wheel_add(s_timerWheel *tw, s_twNode *node, uint64_t expires);
+
+/**
+ * @brief Remove timer from wheel.
+ *
+ * @param[in,out] tw    wheel instance
+ * @param[in,out] node  timer node
+ *
+ * @return false if timer was not pending
+ */
+bool timer_wheel_del(s_timerWheel *tw, s_twNode *node);
+
+/**
+ * @brief Check if timer is pending
+ *
+ * @param[in] node  timer node
+ */
+bool timer_wheel_pending(const s_twNode *node);
+
+/**
+ * @brief Process all ticks up to (and including) now.
+ *
+ * @param[in,out] tw      wheel instance
+ * @param[in]     now     current tick
+ * @param[in]     expire  handler called for every expired timer
+ * @param[in]     user    user data passed to handler
+ *
+ * @return number of expired timers
+ */
+size_t timer_wheel_advance(s_timerWheel *tw, uint64_t now, f_timerWheelExpire expire, void *user);
+
+/** @} */ //End of TIMER_WHEEL
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !IC_TIMER_WHEEL_H */
@@ -0,0 +1,201 @@
+/**
+ * @file    ic_actigraphy.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming actigraphy from accelerometer samples
+ *
+ * Samples are processed in chunks (never across epoch boundary): recursive high-pass of each axis
+ * first, then branch-free magnitude and epoch sums over the whole chunk, eight samples per vector.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_actigraphy.h"
+#include "ic_simd.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define CHUNK 32
+
+/* newest epoch first */
+static const float wake_weight[ACTIGRAPHY_HISTORY] = {1.0f, 0.5f, 0.25f, 0.125f, 0.0625f};
+
+void actigraphy_default_config(s_actigraphyConfig *config, float sample_rate){
+  config->sample_rate = sample_rate;
+  config->mg_per_lsb = 4000.0f/65536.0f;
+  config->highpass = 0.25f;
+  config->epoch = 30.0f;
+  config->threshold = 10.0f;
+  config->movement_pim = 150.0f;
+  config->wake_score = 600.0f;
+}
+
+bool actigraphy_init(s_actigraphyState *state, const s_actigraphyConfig *config){
+  memset(state, 0, sizeof(s_actigraphyState));
+  if(config->sample_rate <= 0 || config->epoch*config->sample_rate < 1.0f) return false;
+  if(config->highpass <= 0 || config->highpass >= config->sample_rate/2) return false;
+
+  state->config = *config;
+  state->hp_alpha = 1.0f/(1.0f + 2.0f*(float)M_PI*config->highpass/config->sample_rate);
+  state->epoch_samples = (uint32_t)(config->epoch*config->sample_rate + 0.5f);
+  return true;
+}
+
+/* First order high-pass y[n] = a*(y[n-1] + x[n] - x[n-1]) of one axis. */
+static void highpass(s_actigraphyState *state, int axis, const int16_t *x, int m, float *y){
+  float a = state->hp_alpha;
+  float h = state->hp[axis];
+  int16_t last = state->last[axis];
+
+  for(int i=0; i<m; ++i){
+    h = a*(h + (float)(x[i] - last));
+    last = x[i];
+    y[i] = h;
+  }
+  state->hp[axis] = h;
+  state->last[axis] = last;
+}
+
+#if IC_SIMD
+
+/* Adds magnitudes of chunk to epoch sum, peak and count above threshold, eight at once. */
+static void magnitudes(const float h[3][CHUNK], int m, float scale, float threshold, float *sum,
+    float *peak, uint32_t *above){
+  v8f32 vsum = {0}, vpeak = {0};
+  v8i32 vabove = {0};
+  int i = 0;
+
+  for(; i + 8 <= m; i += 8){
+    v8f32 x = SIMD_LOAD(v8f32, &h[0][i]);
+    v8f32 y = SIMD_LOAD(v8f32, &h[1][i]);
+    v8f32 z = SIMD_LOAD(v8f32, &h[2][i]);
+    v8f32 sq = x*x + y*y + z*z;
+    v8f32 r = (v8f32)(0x5F375A86 - ((v8i32)sq >> 1));
+    v8f32 mag;
+    v8i32 gt;
+
+    /* sqrt(sq) = sq/sqrt(sq): inverse square root estimate refined by Newton steps to float
+     * precision (sqrtf per lane would not vectorize because of errno); sq = 0 gives 0 */
+    for(int k=0; k<3; ++k)
+      r = r*(1.5f - 0.5f*sq*r*r);
+    mag = scale*sq*r;
+    vsum += mag;
+    gt = mag > vpeak;
+    vpeak = (v8f32)((gt & (v8i32)mag) | (~gt & (v8i32)vpeak));
+    vabove -= mag > threshold;
+  }
+  for(int l=0; l<8; ++l){
+    *sum += vsum[l];
+    *peak = vpeak[l] > *peak ? vpeak[l] : *peak;
+    *above += (uint32_t)vabove[l];
+  }
+  for(; i<m; ++i){
+    float mag = scale*sqrtf(h[0][i]*h[0][i] + h[1][i]*h[1][i] + h[2][i]*h[2][i]);
+    *sum += mag;
+    *peak = mag > *peak ? mag : *peak;
+    *above += mag > threshold;
+  }
+}
+
+#else
+
+static void magnitudes(const float h[3][CHUNK], int m, float scale, float threshold, float *sum,
+    float *peak, uint32_t *above){
+  for(int i=0; i<m; ++i){
+    float mag = scale*sqrtf(h[0][i]*h[0][i] + h[1][i]*h[1][i] + h[2][i]*h[2][i]);
+    *sum += mag;
+    *peak = mag > *peak ? mag : *peak;
+    *above += mag > threshold;
+  }
+}
+
+#endif /* IC_SIMD */
+
+/* Counts crossings of deadband -threshold..threshold (full swings only). */
+static void zero_crossings(s_actigraphyState *state, int axis, const float *y, int m,
+    float threshold){
+  int8_t side = state->side[axis];
+
+  for(int i=0; i<m; ++i){
+    if(y[i] > threshold && side <= 0){
+      if(side < 0) ++state->zc;
+      side = 1;
+    }
+    else if(y[i] < -threshold && side >= 0){
+      if(side > 0) ++state->zc;
+      side = -1;
+    }
+  }
+  state->side[axis] = side;
+}
+
+static void epoch_end(s_actigraphyState *state, s_actigraphyEpoch *out){
+  const s_actigraphyConfig *cfg = &state->config;
+  float score = 0;
+
+  out->index = state->index++;
+  out->pim = state->sum/cfg->sample_rate;
+  out->peak = state->peak;
+  out->tat = state->above/cfg->sample_rate;
+  out->zc = state->zc;
+  out->flags = 0;
+
+  memmove(&state->history[1], &state->history[0], (ACTIGRAPHY_HISTORY-1)*sizeof(float));
+  state->history[0] = out->pim;
+  for(int i=0; i<ACTIGRAPHY_HISTORY; ++i)
+    score += wake_weight[i]*state->history[i];
+  if(out->pim > cfg->movement_pim) out->flags |= ACTIGRAPHY_MOVEMENT;
+  if(score > cfg->wake_score) out->flags |= ACTIGRAPHY_WAKE;
+
+  state->in_epoch = 0;
+  state->sum = 0;
+  state->peak = 0;
+  state->above = 0;
+  state->zc = 0;
+}
+
+size_t actigraphy_process(s_actigraphyState *state, const int16_t *acc_x, const int16_t *acc_y,
+    const int16_t *acc_z, size_t count, s_actigraphyEpoch *out){
+  const float scale = state->config.mg_per_lsb;
+  const float threshold = state->config.threshold;
+  size_t epochs = 0;
+  size_t n = 0;
+
+  if(count && !state->started){
+    state->last[0] = acc_x[0];
+    state->last[1] = acc_y[0];
+    state->last[2] = acc_z[0];
+    state->started = true;
+  }
+
+  while(n < count){
+    float h[3][CHUNK];
+    float sum = 0, peak = state->peak;
+    uint32_t above = 0;
+    int m = CHUNK;
+
+    if((size_t)m > count - n) m = (int)(count - n);
+    if((uint32_t)m > state->epoch_samples - state->in_epoch)
+      m = (int)(state->epoch_samples - state->in_epoch);
+
+    highpass(state, 0, &acc_x[n], m, h[0]);
+    highpass(state, 1, &acc_y[n], m, h[1]);
+    highpass(state, 2, &acc_z[n], m, h[2]);
+
+    magnitudes((const float (*)[CHUNK])h, m, scale, threshold, &sum, &peak, &above);
+    for(int axis=0; axis<3; ++axis)
+      zero_crossings(state, axis, h[axis], m, threshold/scale);
+
+    state->sum += sum;
+    state->peak = peak;
+    state->above += above;
+    state->in_epoch += m;
+    n += m;
+    if(state->in_epoch == state->epoch_samples)
+      epoch_end(state, &out[epochs++]);
+  }
+  return epochs;
+}
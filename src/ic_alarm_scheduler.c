@@ -0,0 +1,79 @@
+/**
+ * @file    ic_alarm_scheduler.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Host side emergency alarm scheduler
+ */
+
+#include "ic_alarm_scheduler.h"
+#include "ic_frame_constructor.h"
+
+static void alarm_expire(s_twNode *node, void *user){
+  s_alarmScheduler *sched = (s_alarmScheduler *)user;
+  s_alarmTimer *timer = TIMER_WHEEL_CONTAINER(node, s_alarmTimer, node);
+  char array[FRAME_SIZE];
+  size_t len = sizeof(array);
+
+  if(alarm_set(array, &len, timer->type, timer->time_to_alarm, timer->timeout,
+        sched->frame_id++) != CMD_UUID)
+    return;
+  timer->set_on_device = true;
+
+  if(timer->escalation && timer->type < ALARM_HARD){
+    ++timer->type;
+    timer_wheel_add(&sched->wheel, &timer->node, node->expires + timer->escalation);
+  }
+
+  sched->handler(timer, array, len, CMD_UUID, sched->user);
+}
+
+void alarm_scheduler_init(s_alarmScheduler *sched, uint64_t now, f_alarmFrameHandler handler,
+    void *user, uint16_t first_id){
+  timer_wheel_init(&sched->wheel, now);
+  sched->handler = handler;
+  sched->user = user;
+  sched->frame_id = first_id;
+}
+
+void alarm_timer_init(s_alarmTimer *timer, void *context){
+  memset(timer, 0, sizeof(s_alarmTimer));
+  timer_wheel_node_init(&timer->node);
+  timer->context = context;
+}
+
+bool alarm_scheduler_arm(s_alarmScheduler *sched, s_alarmTimer *timer, uint64_t at,
+    e_alarmType type, uint32_t time, uint16_t timeout, uint32_t escalation){
+  if(type < ALARM_SOFT || type > ALARM_HARD) return false;
+
+  timer->type = type;
+  timer->time_to_alarm = time;
+  timer->timeout = timeout;
+  timer->escalation = escalation;
+  timer_wheel_add(&sched->wheel, &timer->node, at);
+
+  return true;
+}
+
+bool alarm_scheduler_cancel(s_alarmScheduler *sched, s_alarmTimer *timer){
+  bool cancelled = timer_wheel_del(&sched->wheel, &timer->node);
+
+  if(timer->set_on_device){
+    char array[FRAME_SIZE];
+    size_t len = sizeof(array);
+
+    timer->set_on_device = false;
+    if(alarm_off(array, &len, sched->frame_id++) == CMD_UUID)
+      sched->handler(timer, array, len, CMD_UUID, sched->user);
+    cancelled = true;
+  }
+  return cancelled;
+}
+
+size_t alarm_scheduler_advance(s_alarmScheduler *sched, uint64_t now){
+  return timer_wheel_advance(&sched->wheel, now, alarm_expire, sched);
+}
+
+bool alarm_timer_pending(const s_alarmTimer *timer){
+  return timer_wheel_pending(&timer->node);
+}
@@ -0,0 +1,229 @@
+/**
+ * @file    ic_async.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Asynchronous command/response layer
+ *
+ * Requests are kept in hash table keyed by transport, command and id (which is the first field of
+ * every command payload), so response lookup does not depend on number of requests in flight.
+ */
+
+#include <stdint.h>
+#include "ic_async.h"
+#include "ic_frame_constructor.h"
+
+#define CMD_ID(array) (CAST_AR(array)->frame.payload.device_cmd.id)
+#define LOOPBACK(transport) ((s_asyncLoopback *)(transport))
+
+static s_asyncRequest **bucket_of(s_asyncLoop *loop, const s_asyncTransport *transport, e_cmd cmd,
+    uint16_t id){
+  uintptr_t key = ((uintptr_t)transport>>4) ^ ((uintptr_t)cmd<<11) ^ (uintptr_t)id*0x9E37u;
+  return &loop->bucket[(key ^ (key>>10)) & (ASYNC_BUCKETS-1)];
+}
+
+static void request_unlink(s_asyncLoop *loop, s_asyncRequest *req){
+  *req->pprev = req->next;
+  if(req->next) req->next->pprev = req->pprev;
+  req->next = NULL;
+  req->pprev = NULL;
+  timer_wheel_del(&loop->wheel, &req->timer);
+  --loop->pending;
+}
+
+static void request_complete(s_asyncLoop *loop, s_asyncRequest *req, e_asyncResult result,
+    char *rsp_frame){
+  request_unlink(loop, req);
+  req->done(req, result, rsp_frame, req->user);
+}
+
+static void request_expire(s_twNode *node, void *user){
+  /* timer is already removed from the wheel, timer_wheel_del() in unlink is a no-op */
+  request_complete((s_asyncLoop *)user, TIMER_WHEEL_CONTAINER(node, s_asyncRequest, timer),
+      ASYNC_TIMEOUT, NULL);
+}
+
+void async_loop_init(s_asyncLoop *loop, uint64_t now){
+  memset(loop->bucket, 0, sizeof(loop->bucket));
+  timer_wheel_init(&loop->wheel, now);
+  loop->transports.next = &loop->transports;
+  loop->transports.prev = &loop->transports;
+  loop->now = now;
+  loop->pending = 0;
+}
+
+void async_loop_attach(s_asyncLoop *loop, s_asyncTransport *transport){
+  transport->next = &loop->transports;
+  transport->prev = loop->transports.prev;
+  loop->transports.prev->next = transport;
+  loop->transports.prev = transport;
+}
+
+void async_loop_detach(s_asyncLoop *loop, s_asyncTransport *transport){
+  if(transport->next == NULL) return;
+  transport->prev->next = transport->next;
+  transport->next->prev = transport->prev;
+  transport->next = NULL;
+  transport->prev = NULL;
+
+  for(size_t i=0; i<ASYNC_BUCKETS; ++i){
+    s_asyncRequest *req = loop->bucket[i];
+    while(req){
+      s_asyncRequest *next = req->next;
+      if(req->transport == transport){
+        request_complete(loop, req, ASYNC_DETACHED, NULL);
+        /* handler may have changed the chain */
+        next = loop->bucket[i];
+      }
+      req = next;
+    }
+  }
+}
+
+bool async_send(s_asyncLoop *loop, s_asyncRequest *req, s_asyncTransport *transport,
+    const char *frame, int uuid, uint32_t timeout_ms, f_asyncDone done, void *user){
+  s_asyncRequest **bucket;
+  e_cmd cmd;
+  uint16_t id;
+
+  /* request is not in flight until it is linked below */
+  req->next = NULL;
+  req->pprev = NULL;
+  if(frame == NULL || done == NULL) return false;
+  memcpy(req->frame, frame, FRAME_SIZE);
+  cmd = CAST_AR(req->frame)->frame.cmd;
+  id = CMD_ID(req->frame);
+
+  bucket = bucket_of(loop, transport, cmd, id);
+  for(s_asyncRequest *it = *bucket; it; it = it->next)
+    if(it->transport == transport && CAST_AR(it->frame)->frame.cmd == cmd &&
+        CMD_ID(it->frame) == id)
+      return false;
+
+  if(!transport->send(transport, uuid, req->frame, FRAME_SIZE)) return false;
+
+  req->transport = transport;
+  req->done = done;
+  req->user = user;
+  req->next = *bucket;
+  req->pprev = bucket;
+  if(*bucket) (*bucket)->pprev = &req->next;
+  *bucket = req;
+
+  timer_wheel_node_init(&req->timer);
+  timer_wheel_add(&loop->wheel, &req->timer, loop->now + timeout_ms);
+  ++loop->pending;
+  return true;
+}
+
+bool async_cancel(s_asyncLoop *loop, s_asyncRequest *req){
+  if(req->pprev == NULL) return false;
+  request_unlink(loop, req);
+  return true;
+}
+
+bool async_loop_dispatch(s_asyncLoop *loop, s_asyncTransport *transport, char *frame, size_t len){
+  e_cmd cmd;
+  uint16_t id;
+
+  if(len != FRAME_SIZE) return false;
+  if(!neuroon_cmd_frame_validate((uint8_t *)frame, len)) return false;
+  if(!(CAST_AR(frame)->frame.cmd & RESP(0))) return false;
+
+  cmd = (e_cmd)(CAST_AR(frame)->frame.cmd & ~RESP(0));
+  id = CMD_ID(frame);
+  for(s_asyncRequest *req = *bucket_of(loop, transport, cmd, id); req; req = req->next){
+    if(req->transport == transport && CAST_AR(req->frame)->frame.cmd == cmd &&
+        CMD_ID(req->frame) == id){
+      request_complete(loop, req, ASYNC_OK, frame);
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t async_loop_run_once(s_asyncLoop *loop, uint64_t now){
+  s_asyncTransport cursor;
+  size_t cnt = 0;
+  char frame[FRAME_SIZE];
+  size_t len;
+  int uuid;
+
+  loop->now = now;
+  for(s_asyncTransport *t = loop->transports.next; t != &loop->transports; t = cursor.next){
+    /* cursor is linked after t, so handlers may detach any transport (t included) */
+    cursor.prev = t;
+    cursor.next = t->next;
+    t->next->prev = &cursor;
+    t->next = &cursor;
+
+    while(t->poll && t->next && (len = t->poll(t, &uuid, frame, sizeof(frame))) != 0)
+      if(uuid == RESPONSE_UUID || uuid == STATUS_STREAM_UUID)
+        cnt += async_loop_dispatch(loop, t, frame, len);
+
+    cursor.prev->next = cursor.next;
+    cursor.next->prev = cursor.prev;
+  }
+  cnt += timer_wheel_advance(&loop->wheel, now, request_expire, loop);
+  return cnt;
+}
+
+size_t async_loop_pending(const s_asyncLoop *loop){
+  return loop->pending;
+}
+
+/* ---=== loopback transport ===--- */
+
+static bool loopback_send(s_asyncTransport *transport, int uuid, const char *frame, size_t len){
+  s_asyncLoopback *lb = LOOPBACK(transport);
+  const u_cmdFrameContainer *cmd = (const u_cmdFrameContainer *)frame;
+  char *array;
+  size_t rsp_len = FRAME_SIZE;
+  u_BLECmdPayload payload;
+  s_devsFunc devs_func;
+
+  if(uuid != CMD_UUID || len != FRAME_SIZE) return false;
+  if(lb->head - lb->tail >= ASYNC_LOOPBACK_DEPTH) return false;
+  if(lb->mute) return true;
+
+  array = lb->queue[lb->head & (ASYNC_LOOPBACK_DEPTH-1)];
+  memcpy(&payload, &cmd->frame.payload, sizeof(payload));
+  switch(cmd->frame.cmd){
+    case DEVICE_CMD:
+      dev_resp_frame_gen_func(array, &rsp_len, payload.device_cmd.device,
+          payload.device_cmd.func_type, payload.device_cmd.func_parameter.periodic_func.duration,
+          payload.device_cmd.func_parameter.periodic_func.period, true, payload.device_cmd.id);
+      break;
+    case PULSEOXIMETER_CMD:
+      payload.pox_rsp.state_code = true;
+      resp_frame_copy_func(array, &rsp_len, (char *)&payload, PULSEOXIMETER_CMD);
+      break;
+    case E_ALARM_CMD:
+      payload.alarm_rsp.state_code = true;
+      resp_frame_copy_func(array, &rsp_len, (char *)&payload, E_ALARM_CMD);
+      break;
+    case STATUS_CMD:
+      memset(&devs_func, FUN_TYPE_OFF, sizeof(devs_func));
+      status_rsp_gen_func(array, &rsp_len, devs_func, 0, payload.status_cmd.id);
+      break;
+    default:
+      return true;
+  }
+  ++lb->head;
+  return true;
+}
+
+static size_t loopback_poll(s_asyncTransport *transport, int *uuid, char *frame, size_t len){
+  s_asyncLoopback *lb = LOOPBACK(transport);
+
+  if(lb->head == lb->tail || len < FRAME_SIZE) return 0;
+  memcpy(frame, lb->queue[lb->tail++ & (ASYNC_LOOPBACK_DEPTH-1)], FRAME_SIZE);
+  *uuid = RESPONSE_UUID;
+  return FRAME_SIZE;
+}
+
+void async_loopback_init(s_asyncLoopback *loopback){
+  memset(loopback, 0, sizeof(s_asyncLoopback));
+  loopback->transport.send = loopback_send;
+  loopback->transport.poll = loopback_poll;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file    ic_band_power.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Sliding window EEG band power
+ *
+ * Sliding DFT of kept bins: X_k <- exp(j*2*pi*k/N)*(X_k + x_new - x_old), which is DFT of the
+ * window with the oldest sample first. Float round-off of the recursion would accumulate, so every
+ * BAND_POWER_RESYNC samples (at hop boundary) bins are recomputed directly from the window history
+ * - a few percent of the recursion cost. Hann window is applied in frequency domain:
+ * Y_k = X_k/2 - (X_k-1 + X_k+1)/4, so one extra bin is kept below and above bands.
+ * Samples are processed in chunks of up to eight (never across hop boundary) with bin loop
+ * outside, so bin state stays in registers for the whole chunk.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_band_power.h"
+#include "ic_simd.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define CHUNK             8
+#define BAND_POWER_RESYNC 8192  // samples between exact recomputations of bins
+
+void band_power_default_spec(s_bandPowerSpec *spec, float sample_rate, uint16_t window,
+    uint16_t hop){
+  static const float edge[EEG_BANDS+1] = {0.5f, 4.0f, 8.0f, 12.0f, 16.0f, 30.0f};
+
+  spec->sample_rate = sample_rate;
+  spec->window = window;
+  spec->hop = hop;
+  memcpy(spec->edge, edge, sizeof(edge));
+}
+
+bool band_power_plan(s_bandPowerPlan *plan, const s_bandPowerSpec *spec){
+  double df;
+  int first, last;
+
+  memset(plan, 0, sizeof(s_bandPowerPlan));
+  if(spec->window < 4 || spec->window > BAND_POWER_MAX_WINDOW || spec->hop == 0) return false;
+  if(spec->sample_rate <= 0 || spec->edge[0] <= 0) return false;
+  for(int i=0; i<EEG_BANDS; ++i)
+    if(spec->edge[i+1] <= spec->edge[i]) return false;
+
+  df = (double)spec->sample_rate/spec->window;
+  first = (int)ceil(spec->edge[0]/df);
+  last = (int)ceil(spec->edge[EEG_BANDS]/df) - 1;
+  if(last + 1 > spec->window/2 || last + 3 - first > BAND_POWER_MAX_BINS) return false;
+
+  plan->window = spec->window;
+  plan->hop = spec->hop;
+  plan->bin_lo = (uint16_t)(first - 1);
+  plan->no_of_bins = (uint16_t)(last + 3 - first);
+  for(int i=0; i<=EEG_BANDS; ++i)
+    plan->band_bin[i] = (uint16_t)((int)ceil(spec->edge[i]/df) - plan->bin_lo);
+  /* one-sided power of Hann windowed DFT: 2*|Y|^2/(N*sum(w^2)), sum(w^2) = 3N/8 */
+  plan->scale = 16.0f/(3.0f*spec->window*spec->window);
+  for(int k=0; k<plan->no_of_bins; ++k){
+    double w = 2*M_PI*(plan->bin_lo + k)/spec->window;
+    plan->rot_re[k] = (float)cos(w);
+    plan->rot_im[k] = (float)sin(w);
+  }
+  return true;
+}
+
+void band_power_reset(s_bandPowerState *state){
+  memset(state, 0, sizeof(s_bandPowerState));
+}
+
+/* Direct DFT of window history (oldest sample first), twiddles by double precision rotation. */
+static void band_power_resync(const s_bandPowerPlan *plan, s_bandPowerState *state){
+  for(int k=0; k<plan->no_of_bins; ++k){
+    double w = 2*M_PI*(plan->bin_lo + k)/plan->window;
+    double c = cos(w), s = -sin(w);
+    double tw_re = 1, tw_im = 0;
+    float re[EEG_CHANNELS] = {0}, im[EEG_CHANNELS] = {0};
+    uint16_t pos = state->pos;
+
+    for(uint16_t m=0; m<plan->window; ++m){
+      double t = tw_re*c - tw_im*s;
+      for(int ch=0; ch<EEG_CHANNELS; ++ch){
+        re[ch] += (float)tw_re*state->history[pos][ch];
+        im[ch] += (float)tw_im*state->history[pos][ch];
+      }
+      if(++pos == plan->window) pos = 0;
+      tw_im = tw_re*s + tw_im*c;
+      tw_re = t;
+    }
+    memcpy(state->re[k], re, sizeof(re));
+    memcpy(state->im[k], im, sizeof(im));
+  }
+  state->since_resync = 0;
+}
+
+static void band_power_output(const s_bandPowerPlan *plan, const s_bandPowerState *state,
+    s_bandPower *out){
+  for(int b=0; b<EEG_BANDS; ++b){
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      float sum = 0;
+      for(int k=plan->band_bin[b]; k<plan->band_bin[b+1]; ++k){
+        float re = 0.5f*state->re[k][ch] - 0.25f*(state->re[k-1][ch] + state->re[k+1][ch]);
+        float im = 0.5f*state->im[k][ch] - 0.25f*(state->im[k-1][ch] + state->im[k+1][ch]);
+        sum += re*re + im*im;
+      }
+      out->power[b][ch] = sum*plan->scale;
+    }
+  }
+}
+
+#if IC_SIMD
+
+/* Updates bins with chunk of differences d (new - old), one vector per sample. */
+static void sdft_chunk(const s_bandPowerPlan *plan, s_bandPowerState *state, const v8f32 *d,
+    int m){
+  for(int k=0; k<plan->no_of_bins; ++k){
+    v8f32 re = SIMD_LOAD(v8f32, state->re[k]);
+    v8f32 im = SIMD_LOAD(v8f32, state->im[k]);
+    float c = plan->rot_re[k], s = plan->rot_im[k];
+    for(int i=0; i<m; ++i){
+      v8f32 t = re + d[i];
+      re = c*t - s*im;
+      im = s*t + c*im;
+    }
+    SIMD_STORE(state->re[k], re);
+    SIMD_STORE(state->im[k], im);
+  }
+}
+
+size_t band_power_process(const s_bandPowerPlan *plan, s_bandPowerState *state,
+    const float *const channel[EEG_CHANNELS], size_t count, s_bandPower *out){
+  size_t outputs = 0;
+  size_t n = 0;
+
+  while(n < count){
+    v8f32 d[CHUNK];
+    int m = CHUNK;
+
+    if((size_t)m > count - n) m = (int)(count - n);
+    if(m > plan->hop - state->since_hop) m = plan->hop - state->since_hop;
+
+    if(m == CHUNK){
+      for(int ch=0; ch<EEG_CHANNELS; ++ch)
+        d[ch] = SIMD_LOAD(v8f32, &channel[ch][n]);
+      SIMD_TRANSPOSE8(v8f32, SIMD_SHUFFLE8XF32, d);
+    }
+    else{
+      for(int i=0; i<m; ++i)
+        for(int ch=0; ch<EEG_CHANNELS; ++ch)
+          d[i][ch] = channel[ch][n+i];
+    }
+    for(int i=0; i<m; ++i){
+      v8f32 old = SIMD_LOAD(v8f32, state->history[state->pos]);
+      SIMD_STORE(state->history[state->pos], d[i]);
+      if(++state->pos == plan->window) state->pos = 0;
+      d[i] -= old;
+    }
+    sdft_chunk(plan, state, d, m);
+
+    n += m;
+    state->filled += m;
+    state->since_hop += m;
+    state->since_resync += m;
+    if(state->since_hop == plan->hop){
+      state->since_hop = 0;
+      if(state->since_resync >= BAND_POWER_RESYNC)
+        band_power_resync(plan, state);
+      if(state->filled >= plan->window)
+        band_power_output(plan, state, &out[outputs++]);
+    }
+  }
+  return outputs;
+}
+
+#else
+
+size_t band_power_process(const s_bandPowerPlan *plan, s_bandPowerState *state,
+    const float *const channel[EEG_CHANNELS], size_t count, s_bandPower *out){
+  size_t outputs = 0;
+
+  for(size_t n=0; n<count; ++n){
+    float d[EEG_CHANNELS];
+
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      d[ch] = channel[ch][n] - state->history[state->pos][ch];
+      state->history[state->pos][ch] = channel[ch][n];
+    }
+    if(++state->pos == plan->window) state->pos = 0;
+    for(int k=0; k<plan->no_of_bins; ++k){
+      float c = plan->rot_re[k], s = plan->rot_im[k];
+      for(int ch=0; ch<EEG_CHANNELS; ++ch){
+        float t = state->re[k][ch] + d[ch];
+        state->re[k][ch] = c*t - s*state->im[k][ch];
+        state->im[k][ch] = s*t + c*state->im[k][ch];
+      }
+    }
+    ++state->filled;
+    ++state->since_resync;
+    if(++state->since_hop == plan->hop){
+      state->since_hop = 0;
+      if(state->since_resync >= BAND_POWER_RESYNC)
+        band_power_resync(plan, state);
+      if(state->filled >= plan->window)
+        band_power_output(plan, state, &out[outputs++]);
+    }
+  }
+  return outputs;
+}
+
+#endif /* IC_SIMD */
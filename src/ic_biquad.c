@@ -0,0 +1,53 @@
+/**
+ * @file    ic_biquad.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Second order sections design (audio EQ cookbook formulas)
+ *
+ * Coefficients are computed in double precision and rounded once.
+ */
+
+#include <math.h>
+#include "ic_biquad.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static void normalize(s_biquadCoef *coef, double b0, double b1, double b2, double a0, double a1,
+    double a2){
+  coef->b0 = (float)(b0/a0);
+  coef->b1 = (float)(b1/a0);
+  coef->b2 = (float)(b2/a0);
+  coef->a1 = (float)(a1/a0);
+  coef->a2 = (float)(a2/a0);
+}
+
+void biquad_notch(s_biquadCoef *coef, double fs, double f0, double q){
+  double w0 = 2*M_PI*f0/fs;
+  double alpha = sin(w0)/(2*q);
+  double c = cos(w0);
+
+  normalize(coef, 1, -2*c, 1, 1 + alpha, -2*c, 1 - alpha);
+}
+
+void biquad_highpass(s_biquadCoef *coef, double fs, double f0, double q){
+  double w0 = 2*M_PI*f0/fs;
+  double alpha = sin(w0)/(2*q);
+  double c = cos(w0);
+
+  normalize(coef, (1 + c)/2, -(1 + c), (1 + c)/2, 1 + alpha, -2*c, 1 - alpha);
+}
+
+void biquad_lowpass(s_biquadCoef *coef, double fs, double f0, double q){
+  double w0 = 2*M_PI*f0/fs;
+  double alpha = sin(w0)/(2*q);
+  double c = cos(w0);
+
+  normalize(coef, (1 - c)/2, 1 - c, (1 - c)/2, 1 + alpha, -2*c, 1 - alpha);
+}
+
+double biquad_butterworth_q(unsigned int order, unsigned int k){
+  return 1.0/(2*cos(M_PI*(2*k + 1)/(2*order)));
+}
@@ -0,0 +1,31 @@
+/**
+ * @file    ic_biquad.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Second order sections design (audio EQ cookbook formulas)
+ */
+
+#ifndef IC_BIQUAD_H
+#define IC_BIQUAD_H
+
+#include <stddef.h>
+
+/**
+ * @brief Normalized biquad: y = b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2
+ */
+typedef struct{
+  float b0, b1, b2;
+  float a1, a2;
+}s_biquadCoef;
+
+void biquad_notch(s_biquadCoef *coef, double fs, double f0, double q);
+void biquad_highpass(s_biquadCoef *coef, double fs, double f0, double q);
+void biquad_lowpass(s_biquadCoef *coef, double fs, double f0, double q);
+
+/**
+ * @brief Q of k-th second order section of even order Butterworth filter.
+ */
+double biquad_butterworth_q(unsigned int order, unsigned int k);
+
+#endif /* !IC_BIQUAD_H */
@@ -9,6 +9,7 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include "ic_frame_handle.h"
 
@@ -43,6 +44,45 @@ const char *neuroon_charecteristics[] = { "0201", "0202", "0301",
 const char *dfu_charecteristics[]     = { "0701", "0702",
                                           "0801", "0802" };
 
+/* Binary service UUIDs, bytes in string order; characteristic UUID replaces bytes 2-3. */
+const uint8_t nuc_neuroon_service_uuid[UUID_BINARY_LENGTH] = {
+  0xD0, 0x9E, 0x01, 0x00, 0xD9, 0x7F, 0xE2, 0xD3, 0x84, 0x0C, 0xA1, 0x1C, 0xB8, 0x1C, 0x08, 0x86 };
+const uint8_t nuc_dfu_service_uuid[UUID_BINARY_LENGTH] = {
+  0xC7, 0x35, 0x01, 0x00, 0xD9, 0x7F, 0xE2, 0xD3, 0x84, 0x0C, 0xA1, 0x1C, 0xB8, 0x1C, 0x08, 0x86 };
+
+/*
+ * Perfect hash of 16 bit characteristic UUIDs: ((uuid>>7) + uuid) & 0x0F, i.e. the low nibble of
+ * the UUID plus its bits 7-10 (top bit of the low byte and three low bits of the high byte), modulo
+ * 16. No two characteristics share a slot (checked in test/test.c), so lookup is one load and one
+ * compare. Unused slots hold UUID 0x0000 which is not a valid characteristic.
+ */
+#define UUID_HASH(uuid) ((((uuid)>>7) + (uuid)) & 0x0F)
+
+static const struct{
+  uint16_t uuid;
+  uint8_t characteristic;
+  const uint8_t *service;
+}uuid_routing[16] = {
+  [UUID_HASH(UUID_DATA_STREAM0_TX_CHARACTERISTIC)] =
+    {UUID_DATA_STREAM0_TX_CHARACTERISTIC, DATA_STREAM0_UUID, nuc_neuroon_service_uuid},
+  [UUID_HASH(UUID_DATA_STREAM1_TX_CHARACTERISTIC)] =
+    {UUID_DATA_STREAM1_TX_CHARACTERISTIC, DATA_STREAM1_UUID, nuc_neuroon_service_uuid},
+  [UUID_HASH(UUID_STATUS_STREAM_CHARACTERISTIC)] =
+    {UUID_STATUS_STREAM_CHARACTERISTIC,   STATUS_STREAM_UUID, nuc_neuroon_service_uuid},
+  [UUID_HASH(UUID_RESPONSE_TX_CHARACTERISTIC)] =
+    {UUID_RESPONSE_TX_CHARACTERISTIC,     RESPONSE_UUID, nuc_neuroon_service_uuid},
+  [UUID_HASH(UUID_CMD_RX_CHARACTERISTIC)] =
+    {UUID_CMD_RX_CHARACTERISTIC,          CMD_UUID, nuc_neuroon_service_uuid},
+  [UUID_HASH(UUID_SETTINGS_TX_CHARACTERISTIC)] =
+    {UUID_SETTINGS_TX_CHARACTERISTIC,     SETTINGS_TX_UUID, nuc_dfu_service_uuid},
+  [UUID_HASH(UUID_SETTINGS_RX_CHARACTERISTIC)] =
+    {UUID_SETTINGS_RX_CHARACTERISTIC,     SETTINGS_RX_UUID, nuc_dfu_service_uuid},
+  [UUID_HASH(UUID_DFU_TX_CHARACTERISTIC)] =
+    {UUID_DFU_TX_CHARACTERISTIC,          DFU_TX_UUID, nuc_dfu_service_uuid},
+  [UUID_HASH(UUID_DFU_RX_CHARACTERISTIC)] =
+    {UUID_DFU_RX_CHARACTERISTIC,          DFU_RX_UUID, nuc_dfu_service_uuid},
+};
+
 bool nuc_init(char characteristics[NO_CHARECTERISTICS][UUID_LENGTH+1]){
   size_t cnt = 0;
   for(size_t i=0; i<(sizeof(neuroon_charecteristics)/sizeof(const char *)); ++i){
@@ -56,3 +96,65 @@ bool nuc_init(char characteristics[NO_CHARECTERISTICS][UUID_LENGTH+1]){
   }
   return true;
 }
+
+e_characteristics nuc_characteristic_from_uuid16(uint16_t uuid){
+  size_t slot = UUID_HASH(uuid);
+
+  if(uuid_routing[slot].uuid != uuid || uuid == 0) return ERROR_UUID;
+  return (e_characteristics)uuid_routing[slot].characteristic;
+}
+
+e_characteristics nuc_characteristic_from_uuid128(const uint8_t *uuid, bool little_endian){
+  uint8_t be[UUID_BINARY_LENGTH];
+  const uint8_t *service;
+  size_t slot;
+
+  if(uuid == NULL) return ERROR_UUID;
+  if(little_endian){
+    for(size_t i=0; i<UUID_BINARY_LENGTH; ++i) be[i] = uuid[UUID_BINARY_LENGTH-1-i];
+    uuid = be;
+  }
+
+  slot = UUID_HASH(((uint16_t)uuid[2]<<8) | uuid[3]);
+  service = uuid_routing[slot].service;
+  if(service == NULL || uuid_routing[slot].uuid != (((uint16_t)uuid[2]<<8) | uuid[3]))
+    return ERROR_UUID;
+  if(uuid[0] != service[0] || uuid[1] != service[1] ||
+      memcmp(&uuid[4], &service[4], UUID_BINARY_LENGTH-4) != 0)
+    return ERROR_UUID;
+  return (e_characteristics)uuid_routing[slot].characteristic;
+}
+
+e_characteristics nuc_notification_route(const uint8_t *uuid, size_t uuid_len, bool little_endian,
+    uint8_t *data, uint16_t len){
+  e_characteristics characteristic;
+
+  if(uuid == NULL || data == NULL || len == 0) return ERROR_UUID;
+  switch(uuid_len){
+    case 2:
+      characteristic = nuc_characteristic_from_uuid16(little_endian ?
+          (uint16_t)(uuid[0] | (uuid[1]<<8)) : (uint16_t)((uuid[0]<<8) | uuid[1]));
+      break;
+    case UUID_BINARY_LENGTH:
+      characteristic = nuc_characteristic_from_uuid128(uuid, little_endian);
+      break;
+    default:
+      return ERROR_UUID;
+  }
+
+  switch(characteristic){
+    case DATA_STREAM0_UUID:
+    case DATA_STREAM1_UUID:
+      return len == NUC_FRAME_SIZE ? characteristic : ERROR_UUID;
+    case STATUS_STREAM_UUID:
+    case RESPONSE_UUID:
+      if(len != NUC_FRAME_SIZE || !neuroon_cmd_frame_validate(data, len)) return ERROR_UUID;
+      return characteristic;
+    case SETTINGS_TX_UUID:
+    case DFU_TX_UUID:
+      return characteristic;
+    default:
+      /* mask does not notify on RX characteristics */
+      return ERROR_UUID;
+  }
+}
@@ -0,0 +1,140 @@
+/**
+ * @file    ic_clock_sync.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Device to host clock synchronization
+ *
+ * Regression is done on d = host - nominal device time, against x = nominal device time, both
+ * relative to the first pair, with centred (Welford like) exponentially weighted moments, so
+ * there is no cancellation even after a night of microseconds.
+ */
+
+#include <string.h>
+#include "ic_clock_sync.h"
+
+#define ABS(v) ((v) < 0 ? -(v) : (v))
+#define RESIDUAL_GAIN   0.1   // weight of new residual in its running mean
+#define RESIDUAL_GATE   4.0   // outlier threshold in running mean residuals
+
+static int64_t round_us(double v){
+  return (int64_t)(v < 0 ? v - 0.5 : v + 0.5);
+}
+
+static void regression_reset(s_clockSync *cs){
+  cs->weight = 0;
+  cs->mean_x = 0;
+  cs->mean_d = 0;
+  cs->var_x = 0;
+  cs->cov_xd = 0;
+  cs->residual = 0;
+  cs->skew = 0;
+  cs->windows = 0;
+  cs->delayed = 0;
+  cs->early = 0;
+}
+
+static bool regression_update(s_clockSync *cs, double x, double d){
+  double dx, w;
+
+  if(cs->windows >= CLOCK_SYNC_MIN_WINDOWS){
+    double r = d - (cs->mean_d + cs->skew*(x - cs->mean_x));
+    double gate = RESIDUAL_GATE*cs->residual;
+
+    if(gate < cs->gate_us) gate = cs->gate_us;
+    if(r > gate){
+      ++cs->outliers;
+      cs->early = 0;
+      if(++cs->delayed <= CLOCK_SYNC_MAX_DELAYED) return false;
+      /* persistent disagreement - model is wrong, start again */
+      regression_reset(cs);
+    }
+    else if(r < -gate){
+      ++cs->outliers;
+      cs->delayed = 0;
+      if(++cs->early <= CLOCK_SYNC_MAX_EARLY) return false;
+      regression_reset(cs);
+    }
+    else{
+      cs->residual += RESIDUAL_GAIN*(ABS(r) - cs->residual);
+      cs->delayed = 0;
+      cs->early = 0;
+    }
+  }
+
+  cs->weight = cs->forget*cs->weight + 1.0;
+  w = 1.0/cs->weight;
+  dx = x - cs->mean_x;
+  cs->mean_x += w*dx;
+  cs->mean_d += w*(d - cs->mean_d);
+  cs->var_x = cs->forget*cs->var_x + dx*(x - cs->mean_x);
+  cs->cov_xd = cs->forget*cs->cov_xd + dx*(d - cs->mean_d);
+  ++cs->windows;
+
+  if(cs->windows >= CLOCK_SYNC_MIN_WINDOWS && cs->var_x > 0)
+    cs->skew = cs->cov_xd/cs->var_x;
+  return true;
+}
+
+void clock_sync_init(s_clockSync *cs, uint32_t ticks_per_sec, uint64_t window, double forget,
+    int64_t gate_us){
+  memset(cs, 0, sizeof(s_clockSync));
+  cs->us_per_tick = 1e6/ticks_per_sec;
+  cs->window = window ? window : 1;
+  cs->forget = (forget > 0 && forget <= 1) ? forget : 1;
+  cs->gate_us = gate_us;
+}
+
+bool clock_sync_add(s_clockSync *cs, uint64_t dev_ts, int64_t host_us){
+  bool updated = false;
+  double x, d;
+
+  if(!cs->started){
+    cs->started = true;
+    cs->dev_ref = dev_ts;
+    cs->host_ref = host_us;
+    cs->window_start = dev_ts;
+  }
+
+  x = (double)(int64_t)(dev_ts - cs->dev_ref)*cs->us_per_tick;
+  d = (double)(host_us - cs->host_ref) - x;
+
+  if(cs->win_valid && (int64_t)(dev_ts - cs->window_start) >= (int64_t)cs->window){
+    updated = regression_update(cs, cs->win_x, cs->win_d);
+    cs->window_start = dev_ts;
+    cs->win_valid = false;
+  }
+  if(!cs->win_valid || d < cs->win_d){
+    cs->win_x = x;
+    cs->win_d = d;
+    cs->win_valid = true;
+  }
+  return updated;
+}
+
+bool clock_sync_valid(const s_clockSync *cs){
+  return cs->windows > 0;
+}
+
+int64_t clock_sync_to_host(const s_clockSync *cs, uint64_t dev_ts){
+  int64_t host;
+
+  clock_sync_convert(cs, &dev_ts, 1, &host);
+  return host;
+}
+
+void clock_sync_convert(const s_clockSync *cs, const uint64_t *dev_ts, size_t count,
+    int64_t *host_us){
+  /* host = host_ref + x*(1 + skew) + mean_d - skew*mean_x */
+  double scale = cs->us_per_tick*(1.0 + cs->skew);
+  double offset = cs->mean_d - cs->skew*cs->mean_x;
+  uint64_t dev_ref = cs->dev_ref;
+  int64_t host_ref = cs->host_ref;
+
+  for(size_t n=0; n<count; ++n)
+    host_us[n] = host_ref + round_us((double)(int64_t)(dev_ts[n] - dev_ref)*scale + offset);
+}
+
+double clock_sync_skew(const s_clockSync *cs){
+  return cs->skew;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file    ic_decimator.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming polyphase decimator of EEG channels
+ *
+ * Every input sample vector (one lane per channel, blocks of eight transposed from columns) is
+ * written twice into history of 2*taps entries, so the last taps samples are always contiguous.
+ * Outputs are collected in blocks of eight vectors and transposed back to columns.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_decimator.h"
+#include "ic_simd.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define DECIMATOR_BLOCK 8
+
+void decimator_default_spec(s_decimatorSpec *spec, uint8_t up, uint8_t down){
+  spec->up = up;
+  spec->down = down;
+  spec->taps = 0;
+  spec->passband = 0.8f;
+  spec->attenuation = 80.0f;
+}
+
+/* Zeroth order modified Bessel function of the first kind. */
+static double bessel_i0(double x){
+  double sum = 1, term = 1;
+
+  for(int k=1; k<32; ++k){
+    term *= (x/(2*k))*(x/(2*k));
+    sum += term;
+  }
+  return sum;
+}
+
+bool decimator_design(s_decimator *dec, const s_decimatorSpec *spec){
+  double nyquist, transition, beta, a = spec->attenuation;
+  unsigned int taps = spec->taps, n;
+
+  memset(dec, 0, sizeof(s_decimator));
+  if(spec->up == 0 || spec->down == 0) return false;
+  if(spec->passband <= 0 || spec->passband >= 1 || a <= 0) return false;
+
+  /* output Nyquist in cycles per interpolated sample; passband p*nyq, stopband (2-p)*nyq */
+  nyquist = 0.5/(spec->up > spec->down ? spec->up : spec->down);
+  transition = 2*(1 - spec->passband)*nyquist;
+  beta = a > 50 ? 0.1102*(a - 8.7) : (a > 21 ? 0.5842*pow(a - 21, 0.4) + 0.07886*(a - 21) : 0);
+  if(taps == 0){
+    /* Kaiser estimate of filter length */
+    double length = (a - 7.95)/(14.36*transition) + 1;
+    taps = (unsigned int)ceil(length/spec->up);
+  }
+  n = spec->up*taps;
+  if(taps > DECIMATOR_MAX_TAPS || n > DECIMATOR_MAX_COEFS) return false;
+
+  dec->up = spec->up;
+  dec->down = spec->down;
+  dec->taps = (uint8_t)taps;
+  for(unsigned int i=0; i<n; ++i){
+    double t = i - (n - 1)/2.0;
+    double r = 2.0*i/(n - 1) - 1;
+    double h = t == 0 ? 2*nyquist : sin(2*M_PI*nyquist*t)/(M_PI*t);
+    double w = n > 1 ? bessel_i0(beta*sqrt(1 - r*r))/bessel_i0(beta) : 1;
+    /* tap i of phase p multiplies sample (taps-1-j) back; interpolation gain up */
+    unsigned int phase = i%spec->up, j = taps - 1 - i/spec->up;
+    dec->coef[phase*taps + j] = (float)(h*w*spec->up);
+  }
+  return true;
+}
+
+void decimator_reset(s_decimatorState *state){
+  memset(state, 0, sizeof(s_decimatorState));
+}
+
+#if IC_SIMD
+
+/* vectors are passed by pointer - 32 byte vector arguments have different ABI with and without
+ * AVX */
+static inline void dot(const float *coef, const float (*window)[EEG_CHANNELS], uint8_t taps,
+    v8f32 *y){
+  v8f32 acc0 = {0}, acc1 = {0};
+  uint8_t j = 0;
+
+  for(; j + 1 < taps; j += 2){
+    acc0 += coef[j]*SIMD_LOAD(v8f32, window[j]);
+    acc1 += coef[j+1]*SIMD_LOAD(v8f32, window[j+1]);
+  }
+  if(j < taps) acc0 += coef[j]*SIMD_LOAD(v8f32, window[j]);
+  *y = acc0 + acc1;
+}
+
+size_t decimator_process(const s_decimator *dec, s_decimatorState *state,
+    const float *const in[EEG_CHANNELS], size_t count, float *const out[EEG_CHANNELS]){
+  v8f32 ob[DECIMATOR_BLOCK];
+  int no_of_ob = 0;
+  size_t outputs = 0;
+  size_t n = 0;
+
+  while(n < count){
+    v8f32 r[DECIMATOR_BLOCK];
+    int m = DECIMATOR_BLOCK;
+
+    if(count - n >= DECIMATOR_BLOCK){
+      for(int ch=0; ch<EEG_CHANNELS; ++ch)
+        r[ch] = SIMD_LOAD(v8f32, &in[ch][n]);
+      SIMD_TRANSPOSE8(v8f32, SIMD_SHUFFLE8XF32, r);
+    }
+    else{
+      m = (int)(count - n);
+      for(int i=0; i<m; ++i)
+        for(int ch=0; ch<EEG_CHANNELS; ++ch)
+          r[i][ch] = in[ch][n+i];
+    }
+
+    for(int i=0; i<m; ++i){
+      SIMD_STORE(state->history[state->pos], r[i]);
+      SIMD_STORE(state->history[state->pos + dec->taps], r[i]);
+      if(++state->pos == dec->taps) state->pos = 0;
+
+      for(; state->phase < dec->up; state->phase += dec->down){
+        dot(&dec->coef[state->phase*dec->taps], &state->history[state->pos], dec->taps,
+            &ob[no_of_ob]);
+        if(++no_of_ob == DECIMATOR_BLOCK){
+          SIMD_TRANSPOSE8(v8f32, SIMD_SHUFFLE8XF32, ob);
+          for(int ch=0; ch<EEG_CHANNELS; ++ch)
+            SIMD_STORE(&out[ch][outputs], ob[ch]);
+          outputs += DECIMATOR_BLOCK;
+          no_of_ob = 0;
+        }
+      }
+      state->phase -= dec->up;
+    }
+    n += m;
+  }
+
+  for(int i=0; i<no_of_ob; ++i)
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      out[ch][outputs + i] = ob[i][ch];
+  return outputs + no_of_ob;
+}
+
+#else
+
+size_t decimator_process(const s_decimator *dec, s_decimatorState *state,
+    const float *const in[EEG_CHANNELS], size_t count, float *const out[EEG_CHANNELS]){
+  size_t outputs = 0;
+
+  for(size_t n=0; n<count; ++n){
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      state->history[state->pos][ch] = in[ch][n];
+      state->history[state->pos + dec->taps][ch] = in[ch][n];
+    }
+    if(++state->pos == dec->taps) state->pos = 0;
+
+    for(; state->phase < dec->up; state->phase += dec->down){
+      const float *coef = &dec->coef[state->phase*dec->taps];
+      for(int ch=0; ch<EEG_CHANNELS; ++ch){
+        float y = 0;
+        for(uint8_t j=0; j<dec->taps; ++j)
+          y += coef[j]*state->history[state->pos + j][ch];
+        out[ch][outputs] = y;
+      }
+      ++outputs;
+    }
+    state->phase -= dec->up;
+  }
+  return outputs;
+}
+
+#endif /* IC_SIMD */
@@ -0,0 +1,141 @@
+/**
+ * @file    ic_eeg_filter.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   EEG filter bank (mains notch + Butterworth bandpass)
+ *
+ * Biquads are in transposed direct form II. Blocks of eight samples are transposed from channel
+ * columns to sample vectors (one lane per channel), run through the cascade with state kept in
+ * registers and transposed back.
+ */
+
+#include <string.h>
+#include "ic_eeg_filter.h"
+#include "ic_biquad.h"
+#include "ic_simd.h"
+
+#define EEG_FILTER_BLOCK 8
+
+static void add_section(s_eegFilter *filter, const s_biquadCoef *coef){
+  uint8_t k = filter->no_of_sections++;
+
+  filter->b0[k] = coef->b0;
+  filter->b1[k] = coef->b1;
+  filter->b2[k] = coef->b2;
+  filter->a1[k] = coef->a1;
+  filter->a2[k] = coef->a2;
+}
+
+bool eeg_filter_design(s_eegFilter *filter, const s_eegFilterSpec *spec){
+  float nyquist = spec->sample_rate/2;
+  s_biquadCoef coef;
+
+  memset(filter, 0, sizeof(s_eegFilter));
+  if(spec->sample_rate <= 0 || spec->mains >= nyquist || spec->highpass >= nyquist ||
+      spec->lowpass >= nyquist)
+    return false;
+  if(spec->highpass > 0 && spec->lowpass > 0 && spec->highpass >= spec->lowpass)
+    return false;
+  if((spec->highpass > 0 || spec->lowpass > 0) &&
+      (spec->order == 0 || spec->order%2 || spec->order > EEG_FILTER_MAX_ORDER))
+    return false;
+
+  if(spec->mains > 0){
+    float q = spec->notch_q > 0 ? spec->notch_q : 30;
+    biquad_notch(&coef, spec->sample_rate, spec->mains, q);
+    add_section(filter, &coef);
+    if(spec->notch_harmonic && 2*spec->mains < nyquist){
+      biquad_notch(&coef, spec->sample_rate, 2*spec->mains, q);
+      add_section(filter, &coef);
+    }
+  }
+  for(unsigned int k=0; spec->highpass > 0 && k<spec->order/2u; ++k){
+    biquad_highpass(&coef, spec->sample_rate, spec->highpass, biquad_butterworth_q(spec->order, k));
+    add_section(filter, &coef);
+  }
+  for(unsigned int k=0; spec->lowpass > 0 && k<spec->order/2u; ++k){
+    biquad_lowpass(&coef, spec->sample_rate, spec->lowpass, biquad_butterworth_q(spec->order, k));
+    add_section(filter, &coef);
+  }
+  return true;
+}
+
+void eeg_filter_reset(s_eegFilterState *state){
+  memset(state, 0, sizeof(s_eegFilterState));
+}
+
+#if IC_SIMD
+
+/* vectors are passed by pointer - 32 byte vector arguments have different ABI with and without
+ * AVX */
+static inline void cascade(const s_eegFilter *filter, v8f32 *z1, v8f32 *z2, v8f32 *sample){
+  v8f32 x = *sample;
+
+  for(uint8_t k=0; k<filter->no_of_sections; ++k){
+    v8f32 y = filter->b0[k]*x + z1[k];
+    z1[k] = filter->b1[k]*x - filter->a1[k]*y + z2[k];
+    z2[k] = filter->b2[k]*x - filter->a2[k]*y;
+    x = y;
+  }
+  *sample = x;
+}
+
+void eeg_filter_process(const s_eegFilter *filter, s_eegFilterState *state,
+    float *const channel[EEG_CHANNELS], size_t count){
+  v8f32 z1[EEG_FILTER_MAX_SECTIONS], z2[EEG_FILTER_MAX_SECTIONS];
+  size_t n = 0;
+
+  for(uint8_t k=0; k<filter->no_of_sections; ++k){
+    z1[k] = SIMD_LOAD(v8f32, state->z1[k]);
+    z2[k] = SIMD_LOAD(v8f32, state->z2[k]);
+  }
+
+  for(; n + EEG_FILTER_BLOCK <= count; n += EEG_FILTER_BLOCK){
+    v8f32 r[EEG_FILTER_BLOCK];
+
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      r[ch] = SIMD_LOAD(v8f32, &channel[ch][n]);
+    SIMD_TRANSPOSE8(v8f32, SIMD_SHUFFLE8XF32, r);
+    for(int i=0; i<EEG_FILTER_BLOCK; ++i)
+      cascade(filter, z1, z2, &r[i]);
+    SIMD_TRANSPOSE8(v8f32, SIMD_SHUFFLE8XF32, r);
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      SIMD_STORE(&channel[ch][n], r[ch]);
+  }
+  for(; n<count; ++n){
+    v8f32 x;
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      x[ch] = channel[ch][n];
+    cascade(filter, z1, z2, &x);
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      channel[ch][n] = x[ch];
+  }
+
+  for(uint8_t k=0; k<filter->no_of_sections; ++k){
+    SIMD_STORE(state->z1[k], z1[k]);
+    SIMD_STORE(state->z2[k], z2[k]);
+  }
+}
+
+#else
+
+void eeg_filter_process(const s_eegFilter *filter, s_eegFilterState *state,
+    float *const channel[EEG_CHANNELS], size_t count){
+  for(int ch=0; ch<EEG_CHANNELS; ++ch){
+    float *x = channel[ch];
+    for(uint8_t k=0; k<filter->no_of_sections; ++k){
+      float z1 = state->z1[k][ch], z2 = state->z2[k][ch];
+      for(size_t n=0; n<count; ++n){
+        float y = filter->b0[k]*x[n] + z1;
+        z1 = filter->b1[k]*x[n] - filter->a1[k]*y + z2;
+        z2 = filter->b2[k]*x[n] - filter->a2[k]*y;
+        x[n] = y;
+      }
+      state->z1[k][ch] = z1;
+      state->z2[k][ch] = z2;
+    }
+  }
+}
+
+#endif /* IC_SIMD */
@@ -0,0 +1,209 @@
+/**
+ * @file    ic_eeg_quality.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming EEG signal quality detector
+ *
+ * Blocks of eight samples are transposed from channel columns to sample vectors (one lane per
+ * channel); minimum, maximum and clip count are reduced in int16 lanes, sums of samples, squares
+ * and mains quadrature products in float lanes. Samples are taken relative to the first sample of
+ * the epoch, so float sums do not lose variance of channels with large offset.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_eeg_quality.h"
+#include "ic_simd.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define EEG_QUALITY_BLOCK 8
+
+void eeg_quality_default_spec(s_eegQualitySpec *spec, float sample_rate){
+  spec->sample_rate = sample_rate;
+  spec->window = (uint16_t)(sample_rate + 0.5f);
+  spec->mains = 50.0f;
+  spec->clip_level = 32000;
+  spec->clip_samples = 2;
+  spec->flat_p2p = 4;
+  spec->max_p2p = 30000;
+  spec->line_ratio = 0.5f;
+}
+
+bool eeg_quality_plan(s_eegQualityPlan *plan, const s_eegQualitySpec *spec){
+  memset(plan, 0, sizeof(s_eegQualityPlan));
+  if(spec->sample_rate <= 0 || spec->window < EEG_QUALITY_BLOCK ||
+      spec->window > EEG_QUALITY_MAX_WINDOW)
+    return false;
+  if(spec->mains <= 0 || spec->mains >= spec->sample_rate/2) return false;
+
+  plan->spec = *spec;
+  for(uint16_t n=0; n<spec->window; ++n){
+    double w = 2*M_PI*spec->mains*n/spec->sample_rate;
+    plan->cos[n] = (float)cos(w);
+    plan->sin[n] = (float)sin(w);
+  }
+  return true;
+}
+
+void eeg_quality_reset(s_eegQualityState *state){
+  memset(state, 0, sizeof(s_eegQualityState));
+}
+
+static void epoch_clear(s_eegQualityState *state){
+  for(int ch=0; ch<EEG_CHANNELS; ++ch){
+    state->min[ch] = INT16_MAX;
+    state->max[ch] = INT16_MIN;
+  }
+  memset(state->clip, 0, sizeof(state->clip));
+  memset(state->sum, 0, sizeof(state->sum));
+  memset(state->sum2, 0, sizeof(state->sum2));
+  memset(state->re, 0, sizeof(state->re));
+  memset(state->im, 0, sizeof(state->im));
+  state->pos = 0;
+}
+
+static void epoch_end(const s_eegQualityPlan *plan, s_eegQualityState *state, s_eegQuality *out){
+  const s_eegQualitySpec *spec = &plan->spec;
+  float n = spec->window;
+
+  memset(out, 0, sizeof(s_eegQuality));
+  out->index = state->index++;
+  for(int ch=0; ch<EEG_CHANNELS; ++ch){
+    uint8_t bit = (uint8_t)(1u << ch);
+    int32_t p2p = (int32_t)state->max[ch] - state->min[ch];
+    float mean = state->sum[ch]/n;
+    float variance = state->sum2[ch]/n - mean*mean;
+    /* power of sinusoid at mains: 2*|X|^2/N^2 */
+    float line = 2.0f*(state->re[ch]*state->re[ch] + state->im[ch]*state->im[ch])/(n*n);
+
+    if(state->clip[ch] >= spec->clip_samples) out->clipped |= bit;
+    if(p2p <= spec->flat_p2p) out->flat |= bit;
+    if(p2p >= spec->max_p2p) out->excessive |= bit;
+    if(variance > 0 && line > spec->line_ratio*variance) out->line_noise |= bit;
+  }
+  out->bad = out->clipped | out->flat | out->excessive | out->line_noise;
+  epoch_clear(state);
+}
+
+#if IC_SIMD
+
+typedef struct{
+  v8i16 min, max, clip;
+  v8f32 ref, sum, sum2, re, im;
+}s_lanes;
+
+static void lanes_load(s_lanes *l, const s_eegQualityState *state){
+  l->min = SIMD_LOAD(v8i16, state->min);
+  l->max = SIMD_LOAD(v8i16, state->max);
+  l->clip = SIMD_LOAD(v8i16, state->clip);
+  l->ref = SIMD_LOAD(v8f32, state->ref);
+  l->sum = SIMD_LOAD(v8f32, state->sum);
+  l->sum2 = SIMD_LOAD(v8f32, state->sum2);
+  l->re = SIMD_LOAD(v8f32, state->re);
+  l->im = SIMD_LOAD(v8f32, state->im);
+}
+
+static void lanes_store(s_eegQualityState *state, const s_lanes *l){
+  SIMD_STORE(state->min, l->min);
+  SIMD_STORE(state->max, l->max);
+  SIMD_STORE(state->clip, l->clip);
+  SIMD_STORE(state->ref, l->ref);
+  SIMD_STORE(state->sum, l->sum);
+  SIMD_STORE(state->sum2, l->sum2);
+  SIMD_STORE(state->re, l->re);
+  SIMD_STORE(state->im, l->im);
+}
+
+/* Accumulates one sample vector, returns true when epoch is complete. */
+static inline bool accumulate(const s_eegQualityPlan *plan, s_eegQualityState *state,
+    s_lanes *l, const v8i16 *sample){
+  v8i16 x = *sample;
+  v8i16 lt = x < l->min, gt = x > l->max;
+  v8f32 d;
+
+  if(state->pos == 0)
+    l->ref = __builtin_convertvector(x, v8f32);
+  d = __builtin_convertvector(x, v8f32) - l->ref;
+  l->min = (x & lt) | (l->min & ~lt);
+  l->max = (x & gt) | (l->max & ~gt);
+  l->clip -= (x >= plan->spec.clip_level) | (x <= (int16_t)-plan->spec.clip_level);
+  l->sum += d;
+  l->sum2 += d*d;
+  l->re += plan->cos[state->pos]*d;
+  l->im += plan->sin[state->pos]*d;
+  return ++state->pos == plan->spec.window;
+}
+
+size_t eeg_quality_process(const s_eegQualityPlan *plan, s_eegQualityState *state,
+    const int16_t *const channel[EEG_CHANNELS], size_t count, s_eegQuality *out){
+  size_t epochs = 0;
+  size_t n = 0;
+  s_lanes l;
+
+  if(state->pos == 0) epoch_clear(state);
+  lanes_load(&l, state);
+
+  while(n < count){
+    v8i16 r[EEG_QUALITY_BLOCK];
+    int m = EEG_QUALITY_BLOCK;
+
+    if(count - n >= EEG_QUALITY_BLOCK){
+      for(int ch=0; ch<EEG_CHANNELS; ++ch)
+        r[ch] = SIMD_LOAD(v8i16, &channel[ch][n]);
+      SIMD_TRANSPOSE8(v8i16, SIMD_SHUFFLE8X16, r);
+    }
+    else{
+      m = (int)(count - n);
+      for(int i=0; i<m; ++i)
+        for(int ch=0; ch<EEG_CHANNELS; ++ch)
+          r[i][ch] = channel[ch][n+i];
+    }
+    for(int i=0; i<m; ++i){
+      if(accumulate(plan, state, &l, &r[i])){
+        lanes_store(state, &l);
+        epoch_end(plan, state, &out[epochs++]);
+        lanes_load(&l, state);
+      }
+    }
+    n += m;
+  }
+  lanes_store(state, &l);
+  return epochs;
+}
+
+#else
+
+size_t eeg_quality_process(const s_eegQualityPlan *plan, s_eegQualityState *state,
+    const int16_t *const channel[EEG_CHANNELS], size_t count, s_eegQuality *out){
+  const s_eegQualitySpec *spec = &plan->spec;
+  size_t epochs = 0;
+
+  if(state->pos == 0) epoch_clear(state);
+  for(size_t n=0; n<count; ++n){
+    float c = plan->cos[state->pos], s = plan->sin[state->pos];
+
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      int16_t x = channel[ch][n];
+      float d;
+
+      if(state->pos == 0) state->ref[ch] = x;
+      d = x - state->ref[ch];
+      if(x < state->min[ch]) state->min[ch] = x;
+      if(x > state->max[ch]) state->max[ch] = x;
+      if(x >= spec->clip_level || x <= -spec->clip_level) ++state->clip[ch];
+      state->sum[ch] += d;
+      state->sum2[ch] += d*d;
+      state->re[ch] += c*d;
+      state->im[ch] += s*d;
+    }
+    if(++state->pos == spec->window)
+      epoch_end(plan, state, &out[epochs++]);
+  }
+  return epochs;
+}
+
+#endif /* IC_SIMD */
@@ -25,7 +25,7 @@
 #define PAYLOAD ((u_BLECmdPayload *)payload)
 #define SET_FRAME_SIZE(size) size=sizeof(u_cmdFrameContainer)
 
-#define FRAME_SIZE 20
+#define FRAME_SIZE NUC_FRAME_SIZE
 
 ///////////// COLORS /////////////
 #define RED_COLOR_RED_LED     0x3F
@@ -0,0 +1,228 @@
+/**
+ * @file    ic_lod_pyramid.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Min/max/mean level-of-detail pyramid of EEG recordings
+ *
+ * Memory of all levels which the appended batch will touch is reserved before any bucket is
+ * changed, so failed allocation leaves pyramid as it was. File format (host byte order): magic,
+ * version, base, samples, number of levels, partial bucket with its sums, then for every level
+ * number of buckets and the buckets.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "ic_lod_pyramid.h"
+
+#define LOD_MAGIC     0x444F4C4Eu // "NLOD"
+#define LOD_VERSION   1
+#define MIN_CAPACITY  64
+
+static void partial_clear(s_lodPyramid *lod){
+  for(int ch=0; ch<EEG_CHANNELS; ++ch){
+    lod->partial.min[ch] = INT16_MAX;
+    lod->partial.max[ch] = INT16_MIN;
+    lod->sum[ch] = 0;
+  }
+}
+
+bool lod_pyramid_init(s_lodPyramid *lod, uint32_t base){
+  memset(lod, 0, sizeof(s_lodPyramid));
+  if(base == 0 || (base & (base - 1))) return false;
+  lod->base = base;
+  partial_clear(lod);
+  return true;
+}
+
+void lod_pyramid_free(s_lodPyramid *lod){
+  for(int k=0; k<LOD_MAX_LEVELS; ++k){
+    free(lod->level[k]);
+    lod->level[k] = NULL;
+    lod->count[k] = lod->capacity[k] = 0;
+  }
+  lod->no_of_levels = 0;
+}
+
+static bool reserve(s_lodPyramid *lod, int k, size_t needed){
+  size_t capacity = lod->capacity[k];
+  s_lodBucket *level;
+
+  if(needed <= capacity) return true;
+  capacity = capacity < MIN_CAPACITY ? MIN_CAPACITY : capacity;
+  while(capacity < needed) capacity *= 2;
+  level = (s_lodBucket*)realloc(lod->level[k], capacity*sizeof(s_lodBucket));
+  if(level == NULL) return false;
+  lod->level[k] = level;
+  lod->capacity[k] = capacity;
+  return true;
+}
+
+static void merge(const s_lodBucket *a, const s_lodBucket *b, s_lodBucket *out){
+  for(int ch=0; ch<EEG_CHANNELS; ++ch){
+    out->min[ch] = a->min[ch] < b->min[ch] ? a->min[ch] : b->min[ch];
+    out->max[ch] = a->max[ch] > b->max[ch] ? a->max[ch] : b->max[ch];
+    out->mean[ch] = 0.5f*(a->mean[ch] + b->mean[ch]);
+  }
+}
+
+/* Appends complete level 0 bucket and merges upwards. */
+static void push(s_lodPyramid *lod, const s_lodBucket *bucket){
+  int k = 0;
+
+  lod->level[0][lod->count[0]++] = *bucket;
+  while(lod->count[k]%2 == 0 && k + 1 < LOD_MAX_LEVELS){
+    merge(&lod->level[k][lod->count[k]-2], &lod->level[k][lod->count[k]-1],
+        &lod->level[k+1][lod->count[k+1]]);
+    ++lod->count[++k];
+  }
+  if(k + 1 > lod->no_of_levels) lod->no_of_levels = (uint8_t)(k + 1);
+}
+
+bool lod_pyramid_append(s_lodPyramid *lod, const int16_t *const channel[EEG_CHANNELS],
+    size_t count){
+  uint32_t in_partial = (uint32_t)(lod->samples & (lod->base - 1));
+  size_t added = (in_partial + count)/lod->base;
+  size_t n = 0;
+
+  for(int k=0; k<LOD_MAX_LEVELS && added; ++k){
+    if(!reserve(lod, k, lod->count[k] + added)) return false;
+    added = (lod->count[k]%2 + added)/2;
+  }
+
+  while(n < count){
+    size_t m = lod->base - in_partial;
+
+    if(m > count - n) m = count - n;
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      const int16_t *x = &channel[ch][n];
+      int16_t lo = lod->partial.min[ch], hi = lod->partial.max[ch];
+      int64_t sum = 0;
+
+      for(size_t i=0; i<m; ++i){
+        lo = x[i] < lo ? x[i] : lo;
+        hi = x[i] > hi ? x[i] : hi;
+        sum += x[i];
+      }
+      lod->partial.min[ch] = lo;
+      lod->partial.max[ch] = hi;
+      lod->sum[ch] += sum;
+    }
+    n += m;
+    in_partial += (uint32_t)m;
+    if(in_partial == lod->base){
+      for(int ch=0; ch<EEG_CHANNELS; ++ch)
+        lod->partial.mean[ch] = (float)lod->sum[ch]/lod->base;
+      push(lod, &lod->partial);
+      partial_clear(lod);
+      in_partial = 0;
+    }
+  }
+  lod->samples += count;
+  return true;
+}
+
+typedef struct{
+  int16_t min, max;
+  double sum;
+  uint64_t n;
+}s_cover;
+
+static void cover_add(s_cover *c, int16_t min, int16_t max, double mean, uint64_t n){
+  c->min = min < c->min ? min : c->min;
+  c->max = max > c->max ? max : c->max;
+  c->sum += mean*n;
+  c->n += n;
+}
+
+size_t lod_pyramid_render(const s_lodPyramid *lod, uint8_t channel, uint64_t from, uint64_t to,
+    size_t pixels, s_lodPoint *out){
+  uint32_t in_partial = (uint32_t)(lod->samples & (lod->base - 1));
+  size_t p;
+
+  if(channel >= EEG_CHANNELS || to <= from) return 0;
+  for(p=0; p<pixels; ++p){
+    uint64_t s0 = from + (to - from)*p/pixels;
+    uint64_t s1 = from + (to - from)*(p + 1)/pixels;
+    s_cover c = {INT16_MAX, INT16_MIN, 0, 0};
+    uint64_t s = s0;
+
+    if(s0 >= lod->samples) break;
+    if(s1 > lod->samples) s1 = lod->samples;
+    if(s1 <= s0) s1 = s0 + 1;
+
+    while(s < s1){
+      uint64_t b = s/lod->base;
+      int k = 0;
+
+      if(b >= lod->count[0]){
+        cover_add(&c, lod->partial.min[channel], lod->partial.max[channel],
+            (double)lod->sum[channel]/in_partial, in_partial);
+        break;
+      }
+      /* pixel narrower than bucket or not aligned to it - whole level 0 bucket */
+      if(s%lod->base || s + lod->base > s1){
+        const s_lodBucket *bucket = &lod->level[0][b];
+        cover_add(&c, bucket->min[channel], bucket->max[channel], bucket->mean[channel], lod->base);
+        s = (b + 1)*lod->base;
+        continue;
+      }
+      while(k + 1 < lod->no_of_levels && b%(2ull << k) == 0 &&
+          s + ((uint64_t)lod->base << (k + 1)) <= s1 && (b >> (k + 1)) < lod->count[k+1])
+        ++k;
+      {
+        const s_lodBucket *bucket = &lod->level[k][b >> k];
+        cover_add(&c, bucket->min[channel], bucket->max[channel], bucket->mean[channel],
+            (uint64_t)lod->base << k);
+      }
+      s += (uint64_t)lod->base << k;
+    }
+    out[p].min = c.min;
+    out[p].max = c.max;
+    out[p].mean = c.n ? (float)(c.sum/c.n) : 0;
+  }
+  return p;
+}
+
+bool lod_pyramid_save(const s_lodPyramid *lod, FILE *fp){
+  uint32_t header[2] = {LOD_MAGIC, LOD_VERSION};
+
+  if(fwrite(header, sizeof(header), 1, fp) != 1) return false;
+  if(fwrite(&lod->base, sizeof(lod->base), 1, fp) != 1) return false;
+  if(fwrite(&lod->samples, sizeof(lod->samples), 1, fp) != 1) return false;
+  if(fwrite(&lod->no_of_levels, sizeof(lod->no_of_levels), 1, fp) != 1) return false;
+  if(fwrite(&lod->partial, sizeof(lod->partial), 1, fp) != 1) return false;
+  if(fwrite(lod->sum, sizeof(lod->sum), 1, fp) != 1) return false;
+  for(int k=0; k<lod->no_of_levels; ++k){
+    uint64_t count = lod->count[k];
+    if(fwrite(&count, sizeof(count), 1, fp) != 1) return false;
+    if(count && fwrite(lod->level[k], sizeof(s_lodBucket), count, fp) != count) return false;
+  }
+  return fflush(fp) == 0;
+}
+
+bool lod_pyramid_load(s_lodPyramid *lod, FILE *fp){
+  uint32_t header[2];
+  uint32_t base;
+  int k;
+
+  memset(lod, 0, sizeof(s_lodPyramid));
+  if(fread(header, sizeof(header), 1, fp) != 1) return false;
+  if(header[0] != LOD_MAGIC || header[1] != LOD_VERSION) return false;
+  if(fread(&base, sizeof(base), 1, fp) != 1 || !lod_pyramid_init(lod, base)) return false;
+  if(fread(&lod->samples, sizeof(lod->samples), 1, fp) != 1) return false;
+  if(fread(&lod->no_of_levels, sizeof(lod->no_of_levels), 1, fp) != 1) return false;
+  if(lod->no_of_levels > LOD_MAX_LEVELS) return false;
+  if(fread(&lod->partial, sizeof(lod->partial), 1, fp) != 1) return false;
+  if(fread(lod->sum, sizeof(lod->sum), 1, fp) != 1) return false;
+  for(k=0; k<lod->no_of_levels; ++k){
+    uint64_t count;
+    if(fread(&count, sizeof(count), 1, fp) != 1 || !reserve(lod, k, (size_t)count + 1)) break;
+    if(count && fread(lod->level[k], sizeof(s_lodBucket), count, fp) != count) break;
+    lod->count[k] = (size_t)count;
+  }
+  /* pyramid shorter than one bucket has no levels */
+  if(k == lod->no_of_levels && lod->count[0] == lod->samples/lod->base) return true;
+  lod_pyramid_free(lod);
+  return false;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file    ic_mask_emulator.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Emulated Neuroon mask - command side
+ */
+
+#include "ic_mask_emulator.h"
+#include "ic_frame_constructor.h"
+
+#define EMU(transport) ((s_maskEmulator *)(transport))
+#define DEV_FUNC(emu) ((e_funcType *)&(emu)->devs_func)
+
+static uint32_t emu_random(s_maskEmulator *emu){
+  uint32_t x = emu->rng;
+  x ^= x<<13;
+  x ^= x>>17;
+  x ^= x<<5;
+  emu->rng = x;
+  return x;
+}
+
+/* Reserve place for response notified on uuid, NULL if response is lost. */
+static char *response_slot(s_maskEmulator *emu, uint64_t now, int uuid){
+  s_maskEmuResponse *rsp;
+  uint64_t due = now + emu->config.latency_ms;
+
+  if(emu->config.jitter_ms)
+    due += emu_random(emu) % (emu->config.jitter_ms + 1);
+  if(emu->config.loss_permille && emu_random(emu) % 1000 < emu->config.loss_permille){
+    ++emu->lost;
+    return NULL;
+  }
+  if(emu->head - emu->tail >= MASK_EMU_QUEUE){
+    ++emu->lost;
+    return NULL;
+  }
+
+  /* notifications are delivered in order */
+  if(emu->head != emu->tail){
+    uint64_t last = emu->queue[(emu->head-1) & (MASK_EMU_QUEUE-1)].due;
+    if(due < last) due = last;
+  }
+  rsp = &emu->queue[emu->head++ & (MASK_EMU_QUEUE-1)];
+  rsp->due = due;
+  rsp->uuid = uuid;
+  return rsp->frame;
+}
+
+static bool device_func_allowed(uint8_t device, e_funcType func){
+  if(func < FUN_TYPE_OFF || func > FUN_TYPE_RAMP) return false;
+  if(DEV_CHECK(device, DEV_VIBRATOR) && func == FUN_TYPE_BLINK) return false;
+  if(DEV_CHECK(device, DEV_POWER_LED) && func != FUN_TYPE_OFF && func != FUN_TYPE_ON &&
+      func != FUN_TYPE_BLINK) return false;
+  return true;
+}
+
+static void device_cmd(s_maskEmulator *emu, const s_deviceCmd *cmd, uint64_t now){
+  bool state_code = device_func_allowed(cmd->device, cmd->func_type);
+  size_t len = FRAME_SIZE;
+  char *array;
+
+  if(state_code){
+    for(unsigned int bit=0; bit<sizeof(s_devsFunc); ++bit){
+      if(!DEV_CHECK(cmd->device, 0x01<<bit)) continue;
+      DEV_FUNC(emu)[bit] = cmd->func_type;
+      if(bit < MASK_EMU_INTENSITIES)
+        emu->intensity[bit] = ((const uint8_t *)&cmd->intensity)[bit];
+    }
+    emu->duration = cmd->func_parameter.periodic_func.duration;
+    emu->period = cmd->func_parameter.periodic_func.period;
+  }
+
+  if((array = response_slot(emu, now, RESPONSE_UUID)) == NULL) return;
+  dev_resp_frame_gen_func(array, &len, cmd->device, cmd->func_type,
+      cmd->func_parameter.periodic_func.duration, cmd->func_parameter.periodic_func.period,
+      state_code, cmd->id);
+}
+
+static void pox_cmd(s_maskEmulator *emu, const s_poxCmd *cmd, uint64_t now){
+  u_BLECmdPayload payload;
+  s_poxRsp *rsp = &payload.pox_rsp;
+  t_afe4400Register reg = cmd->request.reg_service.reg;
+  size_t len = FRAME_SIZE;
+  char *array;
+
+  memset(&payload, 0, sizeof(payload));
+  memcpy(rsp, cmd, sizeof(s_poxCmd));
+  rsp->state_code = false;
+
+  switch(cmd->mode){
+    case READ_REG:
+      if(reg >= AFE4400_NO_OF_REGISTERS || reg == AFE4400_CONTROL0) break;
+      if(reg >= AFE4400_LED2VAL && reg < AFE4400_DIAG && !emu->pox_powerdown)
+        emu->pox_reg[reg] = emu_random(emu) & 0x3FFFFF;   // 22 bit ADC output
+      rsp->request.reg_service.reg_val = emu->pox_reg[reg];
+      rsp->state_code = emu->pox_initialized;
+      break;
+    case WRITE_REG:
+      if(reg >= AFE4400_LED2VAL || !emu->pox_initialized) break;
+      emu->pox_reg[reg] = cmd->request.reg_service.reg_val & 0xFFFFFF;
+      rsp->state_code = true;
+      break;
+    case EXEC_FUNC:
+      rsp->state_code = true;
+      switch(cmd->request.function){
+        case HDW_INIT:
+          emu->pox_initialized = true;
+          emu->pox_powerdown = false;
+          for(size_t i=1; i<AFE4400_LED2VAL; ++i) emu->pox_reg[i] = 0;
+          break;
+        case STD_VAL_INIT:
+          for(size_t i=1; i<AFE4400_LED2VAL; ++i) emu->pox_reg[i] = 0;
+          rsp->state_code = emu->pox_initialized;
+          break;
+        case POWERDOWN_ON:
+          emu->pox_powerdown = true;
+          break;
+        case POWERDOWN_OFF:
+          emu->pox_powerdown = false;
+          break;
+        case SELF_TEST:
+          emu->pox_reg[AFE4400_DIAG] = 0;
+          rsp->state_code = emu->pox_initialized;
+          break;
+        default:
+          rsp->state_code = false;
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+
+  if((array = response_slot(emu, now, RESPONSE_UUID)) == NULL) return;
+  resp_frame_copy_func(array, &len, (char *)&payload, PULSEOXIMETER_CMD);
+}
+
+static void alarm_cmd(s_maskEmulator *emu, const s_alarmCmd *cmd, uint64_t now){
+  u_BLECmdPayload payload;
+  size_t len = FRAME_SIZE;
+  char *array;
+
+  memset(&payload, 0, sizeof(payload));
+  memcpy(&payload.alarm_rsp, cmd, sizeof(s_alarmCmd));
+  payload.alarm_rsp.state_code = cmd->type >= ALARM_SOFT && cmd->type <= ALARM_OFF;
+
+  if(payload.alarm_rsp.state_code){
+    emu->alarm_type = cmd->type;
+    emu->alarm_time = cmd->type == ALARM_OFF ? 0 : cmd->time_to_alarm;
+    emu->alarm_timeout = cmd->type == ALARM_OFF ? 0 : cmd->timeout;
+  }
+
+  if((array = response_slot(emu, now, RESPONSE_UUID)) == NULL) return;
+  resp_frame_copy_func(array, &len, (char *)&payload, E_ALARM_CMD);
+}
+
+static void status_cmd(s_maskEmulator *emu, const s_statusCmd *cmd, uint64_t now){
+  size_t len = FRAME_SIZE;
+  char *array;
+
+  /* status is notified on status characteristic, like on the mask */
+  if((array = response_slot(emu, now, STATUS_STREAM_UUID)) == NULL) return;
+  status_rsp_gen_func(array, &len, emu->devs_func, mask_emu_active_data_streams(emu), cmd->id);
+}
+
+/* ---=== transport interface ===--- */
+
+static bool emu_send(s_asyncTransport *transport, int uuid, const char *frame, size_t len){
+  s_maskEmulator *emu = EMU(transport);
+
+  if(uuid != CMD_UUID) return false;
+  mask_emu_receive(emu, frame, len, emu->config.clock ? *emu->config.clock : 0);
+  return true;
+}
+
+static size_t emu_poll(s_asyncTransport *transport, int *uuid, char *frame, size_t len){
+  s_maskEmulator *emu = EMU(transport);
+
+  return mask_emu_poll(emu, emu->config.clock ? *emu->config.clock : 0, uuid, frame, len);
+}
+
+void mask_emu_init(s_maskEmulator *emu, const s_maskEmuConfig *config){
+  memset(emu, 0, sizeof(s_maskEmulator));
+  emu->config = *config;
+  emu->rng = config->seed ? config->seed : 1;
+  memset(&emu->devs_func, FUN_TYPE_OFF, sizeof(s_devsFunc));
+  emu->alarm_type = ALARM_OFF;
+  emu->transport.send = emu_send;
+  emu->transport.poll = emu_poll;
+}
+
+bool mask_emu_receive(s_maskEmulator *emu, const char *frame, size_t len, uint64_t now){
+  u_cmdFrameContainer cmd;
+
+  if(len != FRAME_SIZE || !neuroon_cmd_frame_validate((uint8_t *)frame, len)){
+    ++emu->invalid;
+    return false;
+  }
+  memcpy(&cmd, frame, FRAME_SIZE);
+  ++emu->received;
+
+  switch(cmd.frame.cmd){
+    case DEVICE_CMD:
+      device_cmd(emu, &cmd.frame.payload.device_cmd, now);
+      break;
+    case PULSEOXIMETER_CMD:
+      pox_cmd(emu, &cmd.frame.payload.pox_cmd, now);
+      break;
+    case E_ALARM_CMD:
+      alarm_cmd(emu, &cmd.frame.payload.alarm_cmd, now);
+      break;
+    case STATUS_CMD:
+      status_cmd(emu, &cmd.frame.payload.status_cmd, now);
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+size_t mask_emu_poll(s_maskEmulator *emu, uint64_t now, int *uuid, char *frame, size_t len){
+  s_maskEmuResponse *rsp;
+
+  if(emu->head == emu->tail || len < FRAME_SIZE) return 0;
+  rsp = &emu->queue[emu->tail & (MASK_EMU_QUEUE-1)];
+  if(rsp->due > now) return 0;
+
+  memcpy(frame, rsp->frame, FRAME_SIZE);
+  ++emu->tail;
+  *uuid = rsp->uuid;
+  return FRAME_SIZE;
+}
+
+uint8_t mask_emu_active_data_streams(const s_maskEmulator *emu){
+  s_statusRsp status;
+  uint8_t streams;
+  bool pox = emu->pox_initialized && !emu->pox_powerdown;
+
+  memset(&status.active_data_stream, 0, sizeof(streams));
+  status.active_data_stream.is_eeg_stream_active = 1;
+  status.active_data_stream.is_ir_stream_active = pox;
+  status.active_data_stream.is_red_stream_active = pox;
+  status.active_data_stream.is_acc_stream_active = 1;
+  status.active_data_stream.is_temp_stream_active = 1;
+  memcpy(&streams, &status.active_data_stream, sizeof(streams));
+  return streams;
+}
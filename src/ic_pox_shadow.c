@@ -0,0 +1,138 @@
+/**
+ * @file    ic_pox_shadow.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   AFE4400 register shadow
+ */
+
+#include "ic_pox_shadow.h"
+#include "ic_frame_constructor.h"
+
+#define REG_BIT(reg) (1ull<<(reg))
+#define PENDING_SLOT(shadow, id) (&(shadow)->pending[(id)&(POX_SHADOW_PENDING-1)])
+
+/* Only configuration registers are kept, ADC outputs and DIAG change on their own. */
+static bool is_cacheable(t_afe4400Register reg){
+  return reg != AFE4400_CONTROL0 && reg < AFE4400_LED2VAL;
+}
+
+static bool pending_add(s_poxShadow *shadow, uint16_t id, e_reqMode mode, t_afe4400Register reg,
+    t_afe4400RegisterConf reg_val){
+  s_poxShadowPending *slot = PENDING_SLOT(shadow, id);
+
+  if(slot->used) return false;
+  slot->id = id;
+  slot->mode = mode;
+  slot->reg = reg;
+  slot->reg_val = reg_val;
+  slot->used = true;
+  ++shadow->no_of_pending;
+  return true;
+}
+
+void pox_shadow_init(s_poxShadow *shadow){
+  memset(shadow, 0, sizeof(s_poxShadow));
+}
+
+void pox_shadow_invalidate(s_poxShadow *shadow){
+  pox_shadow_init(shadow);
+}
+
+bool pox_shadow_get(const s_poxShadow *shadow, t_afe4400Register reg,
+    t_afe4400RegisterConf *reg_val){
+  if(reg >= AFE4400_NO_OF_REGISTERS) return false;
+  if(!(shadow->valid & REG_BIT(reg))) return false;
+  *reg_val = shadow->reg_val[reg];
+  return true;
+}
+
+int pox_shadow_read_register(s_poxShadow *shadow, char *array, size_t *len, t_afe4400Register reg,
+    uint16_t id){
+  if(reg >= AFE4400_NO_OF_REGISTERS) return ERROR_UUID;
+  if(PENDING_SLOT(shadow, id)->used) return ERROR_UUID;
+  if(pox_read_register(array, len, reg, id) != CMD_UUID) return ERROR_UUID;
+
+  pending_add(shadow, id, READ_REG, reg, 0);
+  return CMD_UUID;
+}
+
+int pox_shadow_write_register(s_poxShadow *shadow, char *array, size_t *len,
+    t_afe4400Register reg, t_afe4400RegisterConf reg_val, uint16_t id){
+  if(reg >= AFE4400_NO_OF_REGISTERS) return ERROR_UUID;
+  if(PENDING_SLOT(shadow, id)->used) return ERROR_UUID;
+  if(pox_write_register(array, len, reg, reg_val, id) != CMD_UUID) return ERROR_UUID;
+
+  pending_add(shadow, id, WRITE_REG, reg, reg_val);
+  shadow->in_flight |= REG_BIT(reg);
+  shadow->in_flight_val[reg] = reg_val;
+  shadow->in_flight_id[reg] = id;
+  return CMD_UUID;
+}
+
+size_t pox_shadow_program(s_poxShadow *shadow, const s_afe4400RegisterValue *profile, size_t count,
+    char (*frames)[NUC_FRAME_SIZE], size_t max_frames, uint16_t *id){
+  size_t built = 0;
+
+  for(size_t i=0; i<count && built<max_frames; ++i){
+    t_afe4400Register reg = profile[i].reg;
+    t_afe4400RegisterConf reg_val = profile[i].reg_val;
+    size_t len = NUC_FRAME_SIZE;
+
+    if(reg >= AFE4400_NO_OF_REGISTERS) continue;
+    if(shadow->in_flight & REG_BIT(reg)){
+      if(shadow->in_flight_val[reg] == reg_val) continue;
+    }else if((shadow->valid & REG_BIT(reg)) && shadow->reg_val[reg] == reg_val){
+      continue;
+    }
+
+    if(pox_shadow_write_register(shadow, frames[built], &len, reg, reg_val, *id) != CMD_UUID)
+      break;
+    ++(*id);
+    ++built;
+  }
+  return built;
+}
+
+bool pox_shadow_response_sink(s_poxShadow *shadow, char *rsp_frame){
+  s_poxRsp *rsp = &CAST_AR(rsp_frame)->frame.payload.pox_rsp;
+  s_poxShadowPending *slot;
+
+  if(!neuroon_cmd_frame_validate((uint8_t *)rsp_frame, FRAME_SIZE)) return false;
+  if(CAST_AR(rsp_frame)->frame.cmd != RESP(PULSEOXIMETER_CMD)) return false;
+
+  if(rsp->mode == EXEC_FUNC){
+    /* acks of older requests would bring back values the function has overwritten */
+    if(rsp->state_code &&
+        (rsp->request.function == HDW_INIT || rsp->request.function == STD_VAL_INIT))
+      pox_shadow_invalidate(shadow);
+    return true;
+  }
+
+  slot = PENDING_SLOT(shadow, rsp->id);
+  if(!slot->used || slot->id != rsp->id || slot->mode != rsp->mode) return false;
+
+  t_afe4400Register reg = slot->reg;
+  slot->used = false;
+  --shadow->no_of_pending;
+
+  if(slot->mode == WRITE_REG){
+    /* newer write of the same register may still be in flight */
+    if(shadow->in_flight_id[reg] == slot->id)
+      shadow->in_flight &= ~REG_BIT(reg);
+    if(rsp->state_code && is_cacheable(reg)){
+      shadow->reg_val[reg] = slot->reg_val;
+      shadow->valid |= REG_BIT(reg);
+    }else{
+      shadow->valid &= ~REG_BIT(reg);
+    }
+  }else if(rsp->state_code && is_cacheable(reg) && !(shadow->in_flight & REG_BIT(reg))){
+    shadow->reg_val[reg] = rsp->request.reg_service.reg_val;
+    shadow->valid |= REG_BIT(reg);
+  }
+  return true;
+}
+
+size_t pox_shadow_pending(const s_poxShadow *shadow){
+  return shadow->no_of_pending;
+}
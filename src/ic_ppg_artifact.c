@@ -0,0 +1,132 @@
+/**
+ * @file    ic_ppg_artifact.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Motion artifact cancellation of IR/red samples with accelerometer reference
+ *
+ * Reference history is mirrored (every sample written twice), so the last PPG_ARTIFACT_TAPS
+ * samples of an axis are always contiguous and filter, reference power and weight update run over
+ * taps in vector lanes. NLMS: e = d - w.h, w += mu*e*h/(eps + h.h), where d is pulsatile part of
+ * PPG channel and e is its cleaned value.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_ppg_artifact.h"
+#include "ic_simd.h"
+
+#define VECTORS (PPG_ARTIFACT_TAPS/8)
+
+void ppg_artifact_default_config(s_ppgArtifactConfig *config, float sample_rate){
+  config->sample_rate = sample_rate;
+  config->mg_per_lsb = 4000.0f/65536.0f;
+  config->mu = 0.05f;
+  config->min_motion = 5.0f;
+  config->dc_tau = 1.5f;
+}
+
+bool ppg_artifact_init(s_ppgArtifactState *state, const s_ppgArtifactConfig *config){
+  memset(state, 0, sizeof(s_ppgArtifactState));
+  if(config->sample_rate <= 0 || config->mg_per_lsb <= 0 || config->dc_tau <= 0 ||
+      config->mu <= 0 || config->mu >= 2.0f)
+    return false;
+  state->config = *config;
+  state->dc_alpha = 1.0f - expf(-1.0f/(config->sample_rate*config->dc_tau));
+  state->eps = 3*PPG_ARTIFACT_TAPS*config->min_motion*config->min_motion + 1e-6f;
+  return true;
+}
+
+#if IC_SIMD
+
+/* Filters reference window h of all axes for both PPG channels, returns cleaned d. */
+static void nlms(s_ppgArtifactState *state, const float *const h[3], float d[2]){
+  v8f32 power = {0};
+  v8f32 ref[3][VECTORS];
+  float p = state->eps;
+
+  for(int a=0; a<3; ++a)
+    for(int v=0; v<VECTORS; ++v){
+      ref[a][v] = SIMD_LOAD(v8f32, &h[a][8*v]);
+      power += ref[a][v]*ref[a][v];
+    }
+  for(int i=0; i<8; ++i) p += power[i];
+
+  for(int c=0; c<2; ++c){
+    v8f32 acc = {0};
+    float e, step;
+
+    for(int a=0; a<3; ++a)
+      for(int v=0; v<VECTORS; ++v)
+        acc += SIMD_LOAD(v8f32, &state->weight[c][a][8*v])*ref[a][v];
+    e = d[c];
+    for(int i=0; i<8; ++i) e -= acc[i];
+    step = state->config.mu*e/p;
+    for(int a=0; a<3; ++a)
+      for(int v=0; v<VECTORS; ++v){
+        v8f32 w = SIMD_LOAD(v8f32, &state->weight[c][a][8*v]);
+        SIMD_STORE(&state->weight[c][a][8*v], w + step*ref[a][v]);
+      }
+    d[c] = e;
+  }
+}
+
+#else
+
+static void nlms(s_ppgArtifactState *state, const float *const h[3], float d[2]){
+  float p = state->eps;
+
+  for(int a=0; a<3; ++a)
+    for(int k=0; k<PPG_ARTIFACT_TAPS; ++k)
+      p += h[a][k]*h[a][k];
+
+  for(int c=0; c<2; ++c){
+    float e = d[c], step;
+
+    for(int a=0; a<3; ++a)
+      for(int k=0; k<PPG_ARTIFACT_TAPS; ++k)
+        e -= state->weight[c][a][k]*h[a][k];
+    step = state->config.mu*e/p;
+    for(int a=0; a<3; ++a)
+      for(int k=0; k<PPG_ARTIFACT_TAPS; ++k)
+        state->weight[c][a][k] += step*h[a][k];
+    d[c] = e;
+  }
+}
+
+#endif /* IC_SIMD */
+
+void ppg_artifact_process(s_ppgArtifactState *state, const int32_t *ir, const int32_t *red,
+    const int16_t *x, const int16_t *y, const int16_t *z, size_t count, int32_t *ir_out,
+    int32_t *red_out){
+  const int16_t *acc[3] = {x, y, z};
+  const float alpha = state->dc_alpha;
+
+  for(size_t n=0; n<count; ++n){
+    float ppg[2] = {(float)ir[n], (float)red[n]};
+    const float *h[3];
+    float d[2];
+
+    if(!state->started){
+      for(int c=0; c<2; ++c) state->dc_ppg[c] = ppg[c];
+      for(int a=0; a<3; ++a) state->dc_acc[a] = acc[a][n]*state->config.mg_per_lsb;
+      state->started = true;
+    }
+    for(int a=0; a<3; ++a){
+      float g = acc[a][n]*state->config.mg_per_lsb;
+      state->dc_acc[a] += (g - state->dc_acc[a])*alpha;
+      state->history[a][state->pos] = state->history[a][state->pos + PPG_ARTIFACT_TAPS] =
+          g - state->dc_acc[a];
+    }
+    if(++state->pos == PPG_ARTIFACT_TAPS) state->pos = 0;
+    for(int a=0; a<3; ++a) h[a] = &state->history[a][state->pos];
+
+    for(int c=0; c<2; ++c){
+      state->dc_ppg[c] += (ppg[c] - state->dc_ppg[c])*alpha;
+      d[c] = ppg[c] - state->dc_ppg[c];
+    }
+    nlms(state, h, d);
+    ir_out[n] = (int32_t)lrintf(state->dc_ppg[0] + d[0]);
+    red_out[n] = (int32_t)lrintf(state->dc_ppg[1] + d[1]);
+  }
+}
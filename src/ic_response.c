@@ -20,7 +20,7 @@ int dev_resp_frame_gen_func(char *array, size_t *len, uint8_t device, e_funcType
 
   memset(array, 0, FRAME_SIZE);
 
-  priv_response_set(ARRAY, id, device, func, period, duration, state_code);
+  priv_response_set(ARRAY, id, device, func, duration, period, state_code);
 
   priv_wrap_frame(ARRAY, RESP(DEVICE_CMD));
   SET_FRAME_SIZE(*len);
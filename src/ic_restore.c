@@ -0,0 +1,208 @@
+/**
+ * @file    ic_restore.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Mask state restoration after reconnection
+ */
+
+#include "ic_restore.h"
+#include "ic_frame_constructor.h"
+
+#define PENDING_SLOT(cache, id) (&(cache)->pending[(id)&(RESTORE_PENDING-1)])
+#define DEVICE_INTENSITIES 7
+
+/* restoration burst must never overwrite its own commands waiting for response */
+_Static_assert(RESTORE_PENDING >= RESTORE_MAX_FRAMES, "RESTORE_PENDING too small");
+
+static uint16_t frame_id(char *frame){
+  /* id is the first field of every command payload */
+  return CAST_AR(frame)->frame.payload.device_cmd.id;
+}
+
+static void entry_set(s_restoreEntry *entry, char *frame, uint64_t now){
+  memcpy(entry->frame, frame, FRAME_SIZE);
+  entry->acked = now;
+  entry->used = true;
+  entry->replay = false;
+}
+
+static void device_commit(s_restoreCache *cache, char *frame, uint64_t now){
+  uint8_t devices = CAST_AR(frame)->frame.payload.device_cmd.device;
+  size_t cnt = 0;
+
+  for(size_t i=0; i<cache->no_of_device; ++i){
+    cache->owner[i] &= ~devices;
+    if(cache->owner[i] == 0) continue;
+    cache->device[cnt] = cache->device[i];
+    cache->owner[cnt++] = cache->owner[i];
+  }
+  entry_set(&cache->device[cnt], frame, now);
+  cache->owner[cnt++] = devices;
+  cache->no_of_device = cnt;
+}
+
+static void registers_clear(s_restoreCache *cache){
+  for(size_t i=0; i<AFE4400_NO_OF_REGISTERS; ++i)
+    cache->pox_register[i].used = false;
+}
+
+/* Replayed initialization must keep registers - they are replayed right after it. */
+static void pox_commit(s_restoreCache *cache, char *frame, uint64_t now, bool replay){
+  s_poxCmd *cmd = &CAST_AR(frame)->frame.payload.pox_cmd;
+
+  if(cmd->mode == WRITE_REG){
+    if(cmd->request.reg_service.reg < AFE4400_NO_OF_REGISTERS)
+      entry_set(&cache->pox_register[cmd->request.reg_service.reg], frame, now);
+    return;
+  }
+  if(cmd->mode != EXEC_FUNC) return;
+
+  switch(cmd->request.function){
+    case HDW_INIT:
+      /* hardware initialization resets all registers, standard values included */
+      if(!replay){
+        registers_clear(cache);
+        cache->pox_std_val_init.used = false;
+      }
+      entry_set(&cache->pox_hdw_init, frame, now);
+      break;
+    case STD_VAL_INIT:
+      /* standard values overwrite all registers */
+      if(!replay) registers_clear(cache);
+      entry_set(&cache->pox_std_val_init, frame, now);
+      break;
+    case POWERDOWN_ON:
+    case POWERDOWN_OFF:
+      entry_set(&cache->pox_powerdown, frame, now);
+      break;
+    default:
+      break;
+  }
+}
+
+static void alarm_commit(s_restoreCache *cache, char *frame, uint64_t now){
+  if(CAST_AR(frame)->frame.payload.alarm_cmd.type == ALARM_OFF)
+    cache->alarm.used = false;
+  else
+    entry_set(&cache->alarm, frame, now);
+}
+
+/* Copy cached frame to output and give it new id, finish() seals it. */
+static char *emit(s_restoreEntry *entry, char (*frames)[NUC_FRAME_SIZE], size_t *cnt,
+    uint16_t *id){
+  char *frame = frames[(*cnt)++];
+
+  memcpy(frame, entry->frame, FRAME_SIZE);
+  priv_set_cmd_id(CAST_AR(frame), (*id)++);
+  return frame;
+}
+
+static void finish(s_restoreCache *cache, char *frame){
+  priv_calculate_crc(CAST_AR(frame));
+  restore_cache_sent(cache, frame);
+  PENDING_SLOT(cache, frame_id(frame))->replay = true;
+}
+
+/* OFF and BLINK are built without duration (priv_set_function), they last until changed. */
+static bool is_timed(e_funcType func, uint32_t duration){
+  return duration != DEV_INF_DURATION && func != FUN_TYPE_OFF && func != FUN_TYPE_BLINK;
+}
+
+void restore_cache_init(s_restoreCache *cache){
+  memset(cache, 0, sizeof(s_restoreCache));
+}
+
+bool restore_cache_sent(s_restoreCache *cache, char *frame){
+  switch(CAST_AR(frame)->frame.cmd){
+    case DEVICE_CMD:
+    case PULSEOXIMETER_CMD:
+    case E_ALARM_CMD:
+      break;
+    default:
+      return false;
+  }
+  entry_set(PENDING_SLOT(cache, frame_id(frame)), frame, 0);
+  return true;
+}
+
+bool restore_cache_response(s_restoreCache *cache, char *rsp_frame, uint64_t now){
+  s_restoreEntry *slot = PENDING_SLOT(cache, frame_id(rsp_frame));
+
+  if(!slot->used || !frame_resp_cmp(slot->frame, rsp_frame)) return false;
+  slot->used = false;
+
+  switch(CAST_AR(slot->frame)->frame.cmd){
+    case DEVICE_CMD:
+      if(CAST_AR(rsp_frame)->frame.payload.device_rsp.state_code)
+        device_commit(cache, slot->frame, now);
+      break;
+    case PULSEOXIMETER_CMD:
+      if(CAST_AR(rsp_frame)->frame.payload.pox_rsp.state_code)
+        pox_commit(cache, slot->frame, now, slot->replay);
+      break;
+    case E_ALARM_CMD:
+      if(CAST_AR(rsp_frame)->frame.payload.alarm_rsp.state_code)
+        alarm_commit(cache, slot->frame, now);
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+size_t restore_cache_build(s_restoreCache *cache, const s_devsFunc *current, uint64_t now,
+    char (*frames)[NUC_FRAME_SIZE], size_t max_frames, uint16_t *id){
+  size_t cnt = 0;
+  char *frame;
+
+  if(cache->pox_hdw_init.used && cnt<max_frames)
+    finish(cache, emit(&cache->pox_hdw_init, frames, &cnt, id));
+  if(cache->pox_std_val_init.used && cnt<max_frames)
+    finish(cache, emit(&cache->pox_std_val_init, frames, &cnt, id));
+  for(size_t i=0; i<AFE4400_NO_OF_REGISTERS && cnt<max_frames; ++i)
+    if(cache->pox_register[i].used)
+      finish(cache, emit(&cache->pox_register[i], frames, &cnt, id));
+  if(cache->pox_powerdown.used && cnt<max_frames)
+    finish(cache, emit(&cache->pox_powerdown, frames, &cnt, id));
+
+  for(size_t i=0; i<cache->no_of_device && cnt<max_frames; ++i){
+    s_deviceCmd *cmd = &CAST_AR(cache->device[i].frame)->frame.payload.device_cmd;
+    uint32_t duration = cmd->func_parameter.on_func.duration;
+    uint64_t elapsed = now - cache->device[i].acked;
+    uint8_t devices = cache->owner[i];
+
+    if(is_timed(cmd->func_type, duration)){
+      if(elapsed >= duration) continue;
+      duration -= (uint32_t)elapsed;
+    }
+
+    for(unsigned int bit=0; bit<RESTORE_DEVICES; ++bit){
+      e_funcType func = current ? ((const e_funcType *)current)[bit] : FUN_TYPE_OFF;
+      if(DEV_CHECK(devices, 0x01<<bit) && func == cmd->func_type)
+        DEV_RESET(devices, 0x01<<bit);
+    }
+    if(devices == 0) continue;
+
+    frame = emit(&cache->device[i], frames, &cnt, id);
+    cmd = &CAST_AR(frame)->frame.payload.device_cmd;
+    cmd->device = devices;
+    for(unsigned int bit=0; bit<DEVICE_INTENSITIES; ++bit)
+      if(!DEV_CHECK(devices, 0x01<<bit)) ((uint8_t *)&cmd->intensity)[bit] = 0;
+    if(is_timed(cmd->func_type, cmd->func_parameter.on_func.duration))
+      cmd->func_parameter.on_func.duration = duration;
+    finish(cache, frame);
+  }
+
+  if(cache->alarm.used && cnt<max_frames){
+    s_alarmCmd *cmd = &CAST_AR(cache->alarm.frame)->frame.payload.alarm_cmd;
+    uint64_t elapsed = (now - cache->alarm.acked)/1000;
+
+    if(elapsed < cmd->time_to_alarm){
+      frame = emit(&cache->alarm, frames, &cnt, id);
+      CAST_AR(frame)->frame.payload.alarm_cmd.time_to_alarm -= (uint32_t)elapsed;
+      finish(cache, frame);
+    }
+  }
+  return cnt;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file    ic_ring_cache.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Per-device columnar ring cache of recent samples with time range queries
+ *
+ * Writer announces rows it is going to overwrite (reserved) before touching them and publishes
+ * them (head) after. Reader takes rows below head; rows are intact if reserved (loaded after the
+ * data were read) did not reach the lowest row read + capacity - the same validation as sequence
+ * lock, but per row range, so readers of old and new rows do not disturb each other. Time search
+ * of a query may read rows below the slice, those count as read too.
+ */
+
+#include <string.h>
+#include "ic_ring_cache.h"
+
+bool ring_cache_init(s_ringCache *cache, uint32_t capacity, uint64_t *time, uint8_t no_of_columns,
+    const uint8_t *size, void *const *column){
+  memset(cache, 0, sizeof(s_ringCache));
+  if(capacity == 0 || (capacity & (capacity - 1))) return false;
+  if(no_of_columns > RING_CACHE_MAX_COLUMNS || time == NULL) return false;
+
+  cache->mask = capacity - 1;
+  cache->no_of_columns = no_of_columns;
+  cache->time = time;
+  for(uint8_t i=0; i<no_of_columns; ++i){
+    if(column[i] == NULL || size[i] == 0) return false;
+    cache->size[i] = size[i];
+    cache->column[i] = column[i];
+  }
+  return true;
+}
+
+bool ring_cache_init_eeg(s_ringCache *cache, uint32_t capacity, uint64_t *time,
+    int16_t *const channel[RING_CACHE_EEG_COLUMNS]){
+  uint8_t size[RING_CACHE_EEG_COLUMNS];
+  void *column[RING_CACHE_EEG_COLUMNS];
+
+  for(int ch=0; ch<RING_CACHE_EEG_COLUMNS; ++ch){
+    size[ch] = sizeof(int16_t);
+    column[ch] = channel[ch];
+  }
+  return ring_cache_init(cache, capacity, time, RING_CACHE_EEG_COLUMNS, size, column);
+}
+
+bool ring_cache_init_other(s_ringCache *cache, uint32_t capacity, uint64_t *time, int32_t *ir,
+    int32_t *red, int16_t *const acc[3]){
+  const uint8_t size[RING_CACHE_OTHER_COLUMNS] = {sizeof(int32_t), sizeof(int32_t),
+    sizeof(int16_t), sizeof(int16_t), sizeof(int16_t)};
+  void *column[RING_CACHE_OTHER_COLUMNS] = {ir, red, acc[0], acc[1], acc[2]};
+
+  return ring_cache_init(cache, capacity, time, RING_CACHE_OTHER_COLUMNS, size, column);
+}
+
+void ring_cache_append(s_ringCache *cache, const uint64_t *time, const void *const *column,
+    size_t count){
+  uint64_t capacity = (uint64_t)cache->mask + 1;
+  uint64_t head = cache->head;
+  size_t skip = 0;
+
+  if(count == 0) return;
+  if(count > capacity) skip = count - (size_t)capacity;
+
+  __atomic_store_n(&cache->reserved, head + count, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  for(size_t done=skip; done<count;){
+    uint32_t pos = (uint32_t)((head + done) & cache->mask);
+    size_t len = count - done;
+
+    if(len > capacity - pos) len = (size_t)(capacity - pos);
+    memcpy(&cache->time[pos], &time[done], len*sizeof(uint64_t));
+    for(uint8_t i=0; i<cache->no_of_columns; ++i)
+      memcpy(cache->column[i] + (size_t)pos*cache->size[i],
+          (const uint8_t *)column[i] + done*cache->size[i], len*cache->size[i]);
+    done += len;
+  }
+
+  __atomic_store_n(&cache->head, head + count, __ATOMIC_RELEASE);
+}
+
+void ring_cache_append_eeg(s_ringCache *cache, const uint64_t *time, const s_eegColumns *eeg,
+    size_t count){
+  const void *column[RING_CACHE_EEG_COLUMNS];
+
+  for(int ch=0; ch<RING_CACHE_EEG_COLUMNS; ++ch)
+    column[ch] = eeg->channel[ch];
+  ring_cache_append(cache, time, column, count);
+}
+
+void ring_cache_append_other(s_ringCache *cache, const uint64_t *time,
+    const s_otherColumns *other, size_t count){
+  const void *column[RING_CACHE_OTHER_COLUMNS] = {other->ir, other->red, other->acc_x,
+    other->acc_y, other->acc_z};
+
+  ring_cache_append(cache, time, column, count);
+}
+
+/* Rows which may be read: [*oldest, head). */
+static uint64_t readable(const s_ringCache *cache, uint64_t *oldest){
+  uint64_t head = __atomic_load_n(&cache->head, __ATOMIC_ACQUIRE);
+  uint64_t reserved = __atomic_load_n(&cache->reserved, __ATOMIC_ACQUIRE);
+  uint64_t capacity = (uint64_t)cache->mask + 1;
+
+  *oldest = reserved > capacity ? reserved - capacity : 0;
+  return head > *oldest ? head : *oldest;
+}
+
+static void slice_fill(const s_ringCache *cache, uint64_t first, uint64_t end, s_ringSlice *slice){
+  uint32_t pos = (uint32_t)(first & cache->mask);
+  size_t count = (size_t)(end - first);
+  size_t len0 = (size_t)cache->mask + 1 - pos;
+
+  memset(slice, 0, sizeof(s_ringSlice));
+  slice->first = first;
+  slice->checked = first;
+  slice->count = count;
+  if(count == 0) return;
+  slice->len[0] = count < len0 ? count : len0;
+  slice->len[1] = count - slice->len[0];
+  slice->time[0] = &cache->time[pos];
+  for(uint8_t i=0; i<cache->no_of_columns; ++i)
+    slice->column[i][0] = cache->column[i] + (size_t)pos*cache->size[i];
+  if(slice->len[1]){
+    slice->time[1] = cache->time;
+    for(uint8_t i=0; i<cache->no_of_columns; ++i)
+      slice->column[i][1] = cache->column[i];
+  }
+}
+
+/* First row in [lo, hi) with time >= t, *touched is lowered to the lowest row read. */
+static uint64_t lower_bound(const s_ringCache *cache, uint64_t lo, uint64_t hi, uint64_t t,
+    uint64_t *touched){
+  while(lo < hi){
+    uint64_t mid = lo + (hi - lo)/2;
+    if(mid < *touched) *touched = mid;
+    if(__atomic_load_n(&cache->time[mid & cache->mask], __ATOMIC_RELAXED) < t) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+size_t ring_cache_query(const s_ringCache *cache, uint64_t from, uint64_t to, s_ringSlice *slice){
+  uint64_t oldest, head = readable(cache, &oldest);
+  uint64_t touched = head;
+  uint64_t first = lower_bound(cache, oldest, head, from, &touched);
+  uint64_t end = to > from ? lower_bound(cache, first, head, to, &touched) : first;
+
+  slice_fill(cache, first, end, slice);
+  /* rows overwritten during search may have misplaced the slice */
+  if(touched < slice->checked) slice->checked = touched;
+  return slice->count;
+}
+
+size_t ring_cache_last(const s_ringCache *cache, size_t count, s_ringSlice *slice){
+  uint64_t oldest, head = readable(cache, &oldest);
+  uint64_t first = head - oldest > count ? head - count : oldest;
+
+  slice_fill(cache, first, head, slice);
+  return slice->count;
+}
+
+bool ring_cache_valid(const s_ringCache *cache, const s_ringSlice *slice){
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return __atomic_load_n(&cache->reserved, __ATOMIC_RELAXED) <=
+      slice->checked + (uint64_t)cache->mask + 1;
+}
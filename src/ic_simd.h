@@ -0,0 +1,75 @@
+/**
+ * @file    ic_simd.h
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Portable SIMD helpers (GCC/Clang vector extensions)
+ *
+ * Vector types are lowered by the compiler to SSE/AVX on x86 and NEON on ARM, so there are no
+ * intrinsics here. If vector extensions are not available (or host is big-endian, frames are
+ * little-endian) IC_SIMD is 0 and modules use their scalar paths.
+ */
+
+#ifndef IC_SIMD_H
+#define IC_SIMD_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__) && \
+  __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define IC_SIMD 1
+#else
+#define IC_SIMD 0
+#endif
+
+#if IC_SIMD
+
+typedef int16_t   v8i16 __attribute__((vector_size(16)));
+typedef int32_t   v4i32 __attribute__((vector_size(16)));
+typedef uint32_t  v4u32 __attribute__((vector_size(16)));
+typedef int32_t   v8i32 __attribute__((vector_size(32)));
+typedef float     v8f32 __attribute__((vector_size(32)));
+typedef int16_t   v4i16 __attribute__((vector_size(8)));
+typedef int8_t    v4i8  __attribute__((vector_size(4)));
+
+/* Two input shuffle with constant indices (0..N-1 first vector, N..2N-1 second vector). */
+#if defined(__clang__)
+#define SIMD_SHUFFLE8X16(a,b,...) __builtin_shufflevector((v8i16)(a), (v8i16)(b), __VA_ARGS__)
+#define SIMD_SHUFFLE4X32(a,b,...) __builtin_shufflevector((v4u32)(a), (v4u32)(b), __VA_ARGS__)
+#define SIMD_SHUFFLE8XF32(a,b,...) __builtin_shufflevector((v8f32)(a), (v8f32)(b), __VA_ARGS__)
+#else
+#define SIMD_SHUFFLE8X16(a,b,...) __builtin_shuffle((v8i16)(a), (v8i16)(b), (v8i16){__VA_ARGS__})
+#define SIMD_SHUFFLE4X32(a,b,...) __builtin_shuffle((v4u32)(a), (v4u32)(b), (v4u32){__VA_ARGS__})
+#define SIMD_SHUFFLE8XF32(a,b,...) __builtin_shuffle((v8f32)(a), (v8f32)(b), (v8i32){__VA_ARGS__})
+#endif
+
+/*
+ * 8x8 transpose of eight 8-lane vectors (rows become columns) - three stages of interleaving
+ * 1, 2 and 4 lane groups.
+ */
+#define SIMD_TRANSPOSE8(type, shuffle, r) do{                                     \
+  type s_[8], t_[8];                                                              \
+  for(int i_=0; i_<8; i_+=2){                                                     \
+    s_[i_]   = shuffle((r)[i_], (r)[i_+1], 0, 8, 1, 9, 2, 10, 3, 11);             \
+    s_[i_+1] = shuffle((r)[i_], (r)[i_+1], 4, 12, 5, 13, 6, 14, 7, 15);           \
+  }                                                                               \
+  for(int i_=0; i_<8; i_+=4){                                                     \
+    t_[i_]   = shuffle(s_[i_],   s_[i_+2], 0, 1, 8, 9, 2, 3, 10, 11);             \
+    t_[i_+1] = shuffle(s_[i_],   s_[i_+2], 4, 5, 12, 13, 6, 7, 14, 15);           \
+    t_[i_+2] = shuffle(s_[i_+1], s_[i_+3], 0, 1, 8, 9, 2, 3, 10, 11);             \
+    t_[i_+3] = shuffle(s_[i_+1], s_[i_+3], 4, 5, 12, 13, 6, 7, 14, 15);           \
+  }                                                                               \
+  for(int i_=0; i_<4; ++i_){                                                      \
+    (r)[2*i_]   = shuffle(t_[i_], t_[i_+4], 0, 1, 2, 3, 8, 9, 10, 11);            \
+    (r)[2*i_+1] = shuffle(t_[i_], t_[i_+4], 4, 5, 6, 7, 12, 13, 14, 15);          \
+  }                                                                               \
+}while(0)
+
+/* Unaligned load/store, compiled to single vector instruction. */
+#define SIMD_LOAD(type, ptr) ({ type v_; memcpy(&v_, (ptr), sizeof(type)); v_; })
+#define SIMD_STORE(ptr, v) do{ __typeof__(v) v_ = (v); memcpy((ptr), &v_, sizeof(v_)); }while(0)
+
+#endif /* IC_SIMD */
+
+#endif /* !IC_SIMD_H */
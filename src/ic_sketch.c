@@ -0,0 +1,210 @@
+/**
+ * @file    ic_sketch.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Mergeable streaming statistics sketches for nightly summaries
+ *
+ * t-digest: values are buffered and, when buffer is full, sorted together with centroids and
+ * merged left to right while the merged centroid spans at most one unit of scale function
+ * k(q) = COMPRESSION/(2*pi)*asin(2q - 1). Two adjacent centroids always span more than one unit
+ * and k spans COMPRESSION/2 units, so there are never more than COMPRESSION + 1 centroids.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ic_sketch.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+void sketch_moments_reset(s_sketchMoments *sketch){
+  memset(sketch, 0, sizeof(s_sketchMoments));
+  sketch->min = INFINITY;
+  sketch->max = -INFINITY;
+}
+
+void sketch_moments_add(s_sketchMoments *sketch, const float *value, size_t count){
+  for(size_t n=0; n<count; ++n){
+    double delta;
+
+    if(isnan(value[n])) continue;
+    ++sketch->count;
+    delta = value[n] - sketch->mean;
+    sketch->mean += delta/sketch->count;
+    sketch->m2 += delta*(value[n] - sketch->mean);
+    if(value[n] < sketch->min) sketch->min = value[n];
+    if(value[n] > sketch->max) sketch->max = value[n];
+  }
+}
+
+void sketch_moments_merge(s_sketchMoments *dst, const s_sketchMoments *src){
+  double count, delta;
+
+  if(src->count == 0) return;
+  if(dst->count == 0){
+    *dst = *src;
+    return;
+  }
+  count = (double)dst->count + src->count;
+  delta = src->mean - dst->mean;
+  dst->mean += delta*src->count/count;
+  dst->m2 += src->m2 + delta*delta*dst->count*src->count/count;
+  dst->count += src->count;
+  if(src->min < dst->min) dst->min = src->min;
+  if(src->max > dst->max) dst->max = src->max;
+}
+
+double sketch_moments_variance(const s_sketchMoments *sketch){
+  return sketch->count < 2 ? 0 : sketch->m2/(sketch->count - 1);
+}
+
+void sketch_quantiles_reset(s_sketchQuantiles *sketch){
+  memset(sketch, 0, sizeof(s_sketchQuantiles));
+  sketch->min = INFINITY;
+  sketch->max = -INFINITY;
+}
+
+static int centroid_compare(const void *a, const void *b){
+  double ma = ((const s_sketchCentroid*)a)->mean, mb = ((const s_sketchCentroid*)b)->mean;
+  return (ma > mb) - (ma < mb);
+}
+
+static double k_scale(double q){
+  return SKETCH_COMPRESSION/(2*M_PI)*asin(2*q - 1);
+}
+
+static double k_inverse(double k){
+  return (sin(k*2*M_PI/SKETCH_COMPRESSION) + 1)/2;
+}
+
+/* Merges sorted centroids c (total weight) into sketch centroids. */
+static void compress(s_sketchQuantiles *sketch, s_sketchCentroid *c, size_t count, double weight){
+  s_sketchCentroid *out = sketch->centroid;
+  double q_limit = k_inverse(k_scale(0) + 1)*weight;
+  double so_far = 0;
+  size_t m = 0;
+
+  qsort(c, count, sizeof(s_sketchCentroid), centroid_compare);
+  for(size_t i=0; i<count; ++i){
+    if(m && (so_far + c[i].weight <= q_limit || m == SKETCH_CENTROIDS)){
+      /* merge into current centroid */
+      out[m-1].weight += c[i].weight;
+      out[m-1].mean += (c[i].mean - out[m-1].mean)*c[i].weight/out[m-1].weight;
+    }
+    else{
+      if(m) q_limit = k_inverse(k_scale(so_far/weight) + 1)*weight;
+      out[m++] = c[i];
+    }
+    so_far += c[i].weight;
+  }
+  sketch->no_of_centroids = (uint16_t)m;
+  sketch->weight = weight;
+}
+
+/* Compresses buffer and optionally centroids of other sketch into sketch. */
+static void flush(s_sketchQuantiles *sketch, const s_sketchQuantiles *other){
+  s_sketchCentroid c[2*(SKETCH_CENTROIDS + SKETCH_BUFFER)];
+  double weight = sketch->weight;
+  size_t count = sketch->no_of_centroids;
+
+  memcpy(c, sketch->centroid, count*sizeof(s_sketchCentroid));
+  for(uint16_t i=0; i<sketch->no_of_buffered; ++i)
+    c[count++] = (s_sketchCentroid){sketch->buffer[i], 1};
+  weight += sketch->no_of_buffered;
+  if(other){
+    memcpy(&c[count], other->centroid, other->no_of_centroids*sizeof(s_sketchCentroid));
+    count += other->no_of_centroids;
+    for(uint16_t i=0; i<other->no_of_buffered; ++i)
+      c[count++] = (s_sketchCentroid){other->buffer[i], 1};
+    weight += other->weight + other->no_of_buffered;
+  }
+  sketch->no_of_buffered = 0;
+  if(count) compress(sketch, c, count, weight);
+}
+
+void sketch_quantiles_add(s_sketchQuantiles *sketch, const float *value, size_t count){
+  for(size_t n=0; n<count; ++n){
+    if(isnan(value[n])) continue;
+    if(value[n] < sketch->min) sketch->min = value[n];
+    if(value[n] > sketch->max) sketch->max = value[n];
+    sketch->buffer[sketch->no_of_buffered++] = value[n];
+    if(sketch->no_of_buffered == SKETCH_BUFFER) flush(sketch, NULL);
+  }
+}
+
+void sketch_quantiles_merge(s_sketchQuantiles *dst, const s_sketchQuantiles *src){
+  if(src->no_of_centroids == 0 && src->no_of_buffered == 0) return;
+  if(src->min < dst->min) dst->min = src->min;
+  if(src->max > dst->max) dst->max = src->max;
+  flush(dst, src);
+}
+
+float sketch_quantiles_get(s_sketchQuantiles *sketch, float q){
+  const s_sketchCentroid *c = sketch->centroid;
+  double target, left = 0;
+  uint16_t m;
+
+  if(sketch->no_of_buffered) flush(sketch, NULL);
+  m = sketch->no_of_centroids;
+  if(m == 0) return NAN;
+  if(q <= 0) return sketch->min;
+  if(q >= 1) return sketch->max;
+
+  /* centroid i is centered at cumulative weight left + weight/2, ends interpolate to min/max */
+  target = q*sketch->weight;
+  if(target < c[0].weight/2){
+    return (float)(sketch->min + (c[0].mean - sketch->min)*target/(c[0].weight/2));
+  }
+  for(uint16_t i=0; i+1<m; ++i){
+    double center = left + c[i].weight/2;
+    double next = left + c[i].weight + c[i+1].weight/2;
+
+    if(target < next)
+      return (float)(c[i].mean + (c[i+1].mean - c[i].mean)*(target - center)/(next - center));
+    left += c[i].weight;
+  }
+  left += c[m-1].weight/2;
+  if(sketch->weight - left <= 0) return sketch->max;
+  return (float)(c[m-1].mean + (sketch->max - c[m-1].mean)*(target - left)/(sketch->weight - left));
+}
+
+bool sketch_histogram_init(s_sketchHistogram *sketch, float lo, float hi){
+  memset(sketch, 0, sizeof(s_sketchHistogram));
+  if(!(hi > lo)) return false;
+  sketch->lo = lo;
+  sketch->hi = hi;
+  return true;
+}
+
+void sketch_histogram_add(s_sketchHistogram *sketch, const float *value, size_t count){
+  const float scale = SKETCH_HISTOGRAM_BINS/(sketch->hi - sketch->lo);
+
+  for(size_t n=0; n<count; ++n){
+    float x = value[n];
+    int bin;
+
+    if(isnan(x)) continue;
+    if(x < sketch->lo){
+      ++sketch->under;
+      continue;
+    }
+    if(x >= sketch->hi){
+      ++sketch->over;
+      continue;
+    }
+    bin = (int)((x - sketch->lo)*scale);
+    ++sketch->bin[bin < SKETCH_HISTOGRAM_BINS ? bin : SKETCH_HISTOGRAM_BINS - 1];
+  }
+}
+
+bool sketch_histogram_merge(s_sketchHistogram *dst, const s_sketchHistogram *src){
+  if(dst->lo != src->lo || dst->hi != src->hi) return false;
+  for(int i=0; i<SKETCH_HISTOGRAM_BINS; ++i)
+    dst->bin[i] += src->bin[i];
+  dst->under += src->under;
+  dst->over += src->over;
+  return true;
+}
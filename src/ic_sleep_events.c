@@ -0,0 +1,197 @@
+/**
+ * @file    ic_sleep_events.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming sleep spindle and K-complex detector
+ *
+ * Samples are processed in chunks: chunk is copied twice and band-passed in place by the (vector)
+ * filter bank, then per channel state machines run over the chunk. Spindle thresholds are compared
+ * in mean square domain, so there is no square root per sample; baseline is frozen during spindles,
+ * so a spindle does not raise its own threshold. Spindle forced to end at maximal duration releases
+ * the baseline: it jumps to mean square of the whole episode, otherwise a lasting rise of sigma
+ * activity would restart spindles against the old level forever. K-complex band is low-pass only -
+ * its half-waves are delimited by zero crossings, so input must already be high-passed (e.g. 0.5 Hz
+ * of @ref eeg_filter_process).
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_sleep_events.h"
+
+#define CHUNK       64
+#define MS_TAU      0.1f    // sigma mean square smoothing [s]
+#define BASE_TAU    30.0f   // baseline [s]
+#define WARM_UP     10.0f   // [s]
+#define NONE        UINT64_MAX
+
+void sleep_events_default_spec(s_sleepEventSpec *spec, float sample_rate){
+  spec->sample_rate = sample_rate;
+  spec->sigma_low = 11.0f;
+  spec->sigma_high = 16.0f;
+  spec->spindle_start = 2.5f;
+  spec->spindle_end = 1.5f;
+  spec->spindle_min_p2p = 15.0f;
+  spec->spindle_min = 0.5f;
+  spec->spindle_max = 3.0f;
+  spec->spindle_refractory = 1.0f;
+  spec->kc_lowpass = 4.0f;
+  spec->kc_min_p2p = 75.0f;
+  spec->kc_min_trough = 40.0f;
+  spec->kc_min = 0.5f;
+  spec->kc_max = 1.5f;
+}
+
+bool sleep_events_plan(s_sleepEventPlan *plan, const s_sleepEventSpec *spec){
+  s_eegFilterSpec sigma = {spec->sample_rate, 0, 0, false, spec->sigma_low, spec->sigma_high, 4};
+  s_eegFilterSpec slow = {spec->sample_rate, 0, 0, false, 0, spec->kc_lowpass, 2};
+  float fs = spec->sample_rate;
+
+  memset(plan, 0, sizeof(s_sleepEventPlan));
+  if(spec->sigma_low <= 0 || spec->sigma_high <= spec->sigma_low || spec->kc_lowpass <= 0 ||
+      spec->spindle_refractory < 0)
+    return false;
+  if(!eeg_filter_design(&plan->sigma, &sigma) || !eeg_filter_design(&plan->slow, &slow))
+    return false;
+
+  plan->spec = *spec;
+  plan->ms_alpha = 1.0f - expf(-1.0f/(MS_TAU*fs));
+  plan->base_alpha = 1.0f - expf(-1.0f/(BASE_TAU*fs));
+  plan->start2 = spec->spindle_start*spec->spindle_start;
+  plan->end2 = spec->spindle_end*spec->spindle_end;
+  plan->warm_up = (uint32_t)(WARM_UP*fs);
+  plan->spindle_min = (uint32_t)(spec->spindle_min*fs);
+  plan->spindle_max = (uint32_t)(spec->spindle_max*fs);
+  plan->spindle_refractory = (uint32_t)(spec->spindle_refractory*fs);
+  plan->kc_min = (uint32_t)(spec->kc_min*fs);
+  plan->kc_max = (uint32_t)(spec->kc_max*fs);
+  return true;
+}
+
+void sleep_events_reset(s_sleepEventState *state){
+  memset(state, 0, sizeof(s_sleepEventState));
+  for(int ch=0; ch<EEG_CHANNELS; ++ch)
+    state->fall_at[ch] = state->rise_at[ch] = NONE;
+}
+
+static void emit(s_sleepEventState *state, s_sleepEvent *event, size_t max_events, size_t *events,
+    const s_sleepEvent *e){
+  if(*events < max_events) event[(*events)++] = *e;
+  else ++state->dropped;
+}
+
+static void spindles(const s_sleepEventPlan *plan, s_sleepEventState *state, int ch,
+    const float *x, int m, s_sleepEvent *event, size_t max_events, size_t *events){
+  float ms = state->ms[ch], base = state->base[ch], last = state->sigma_last[ch];
+
+  for(int i=0; i<m; ++i){
+    uint64_t now = state->now + i;
+    float x2 = x[i]*x[i];
+
+    ms += (x2 - ms)*plan->ms_alpha;
+    if(!state->spindle[ch]){
+      base += (ms - base)*plan->base_alpha;
+      if(now >= plan->warm_up && now >= state->armed_at[ch] && ms > plan->start2*base){
+        state->spindle[ch] = true;
+        state->spindle_at[ch] = now;
+        state->spindle_lo[ch] = state->spindle_hi[ch] = x[i];
+        state->crossings[ch] = 0;
+        state->spindle_sum[ch] = x2;
+      }
+    }
+    else{
+      uint64_t length = now - state->spindle_at[ch];
+
+      if(x[i] < state->spindle_lo[ch]) state->spindle_lo[ch] = x[i];
+      if(x[i] > state->spindle_hi[ch]) state->spindle_hi[ch] = x[i];
+      if((last < 0) != (x[i] < 0)) ++state->crossings[ch];
+      state->spindle_sum[ch] += x2;
+
+      if(ms < plan->end2*base || length > plan->spindle_max){
+        float p2p = state->spindle_hi[ch] - state->spindle_lo[ch];
+
+        if(length >= plan->spindle_min && length <= plan->spindle_max &&
+            p2p >= plan->spec.spindle_min_p2p){
+          float duration = length/plan->spec.sample_rate;
+          s_sleepEvent e = {SLEEP_EVENT_SPINDLE, (uint8_t)ch, state->spindle_at[ch], duration, p2p,
+            state->crossings[ch]/(2*duration)};
+          emit(state, event, max_events, events, &e);
+        }
+        if(length > plan->spindle_max) base = state->spindle_sum[ch]/(length + 1);
+        state->spindle[ch] = false;
+        state->armed_at[ch] = now + plan->spindle_refractory;
+      }
+    }
+    last = x[i];
+  }
+  state->ms[ch] = ms;
+  state->base[ch] = base;
+  state->sigma_last[ch] = last;
+}
+
+static void k_complexes(const s_sleepEventPlan *plan, s_sleepEventState *state, int ch,
+    const float *x, int m, s_sleepEvent *event, size_t max_events, size_t *events){
+  const s_sleepEventSpec *spec = &plan->spec;
+  float last = state->slow_last[ch];
+
+  for(int i=0; i<m; ++i){
+    uint64_t now = state->now + i;
+
+    if(last >= 0 && x[i] < 0){
+      /* end of positive half-wave - check negative + positive wave before it */
+      if(state->fall_at[ch] != NONE && state->rise_at[ch] != NONE &&
+          state->rise_at[ch] > state->fall_at[ch]){
+        uint64_t length = now - state->fall_at[ch];
+        float p2p = state->peak[ch] - state->trough[ch];
+
+        if(length >= plan->kc_min && length <= plan->kc_max && p2p >= spec->kc_min_p2p &&
+            -state->trough[ch] >= spec->kc_min_trough){
+          float duration = length/spec->sample_rate;
+          s_sleepEvent e = {SLEEP_EVENT_K_COMPLEX, (uint8_t)ch, state->fall_at[ch], duration, p2p,
+            1.0f/duration};
+          emit(state, event, max_events, events, &e);
+        }
+      }
+      state->fall_at[ch] = now;
+      state->trough[ch] = x[i];
+    }
+    else if(last < 0 && x[i] >= 0){
+      state->rise_at[ch] = now;
+      state->peak[ch] = x[i];
+    }
+    if(x[i] < 0 && x[i] < state->trough[ch]) state->trough[ch] = x[i];
+    if(x[i] >= 0 && x[i] > state->peak[ch]) state->peak[ch] = x[i];
+    last = x[i];
+  }
+  state->slow_last[ch] = last;
+}
+
+size_t sleep_events_process(const s_sleepEventPlan *plan, s_sleepEventState *state,
+    const float *const channel[EEG_CHANNELS], size_t count, s_sleepEvent *event,
+    size_t max_events){
+  size_t events = 0;
+  size_t n = 0;
+
+  while(n < count){
+    float sigma[EEG_CHANNELS][CHUNK], slow[EEG_CHANNELS][CHUNK];
+    float *sigma_col[EEG_CHANNELS], *slow_col[EEG_CHANNELS];
+    int m = count - n < CHUNK ? (int)(count - n) : CHUNK;
+
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      memcpy(sigma[ch], &channel[ch][n], m*sizeof(float));
+      memcpy(slow[ch], &channel[ch][n], m*sizeof(float));
+      sigma_col[ch] = sigma[ch];
+      slow_col[ch] = slow[ch];
+    }
+    eeg_filter_process(&plan->sigma, &state->sigma, sigma_col, m);
+    eeg_filter_process(&plan->slow, &state->slow, slow_col, m);
+
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      spindles(plan, state, ch, sigma[ch], m, event, max_events, &events);
+      k_complexes(plan, state, ch, slow[ch], m, event, max_events, &events);
+    }
+    state->now += m;
+    n += m;
+  }
+  return events;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file    ic_sleep_stage.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Sleep stage classifier over streamed epoch features
+ *
+ * Model is a boosted tree ensemble in the layout exported by common GBT trainers for multi-class
+ * problems: every tree adds its leaf value to score of one stage, stage with the highest score
+ * wins. Trees are flat node tables supplied by caller, so model can be replaced by regenerating
+ * tables without touching the code.
+ *
+ * Placeholder tables below are NOT trained: thresholds and leaf scores are hand-set from textbook
+ * band ratios (delta for N3, sigma for N2, theta for REM/N1, alpha/beta and movement for wake) so
+ * the pipeline can be exercised end to end. They are compiled only on explicit request.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_sleep_stage.h"
+
+#define STICKY        0.3f  // score bonus of previous stage (stages rarely change every epoch)
+#define POWER_FLOOR   1e-3f // [uV^2], avoids log of zero
+
+#ifdef IC_SLEEP_STAGE_PLACEHOLDER
+static const s_sleepTree placeholder[] = {
+  SLEEP_TREE(SLEEP_STAGE_WAKE, SLEEP_NODE(LOG_PIM, 2.0f, 1, 2), SLEEP_NODE(REL_BETA, 0.15f, 3, 4),
+      SLEEP_LEAF(2.0f), SLEEP_LEAF(-1.0f), SLEEP_LEAF(0.8f)),
+  SLEEP_TREE(SLEEP_STAGE_WAKE, SLEEP_NODE(REL_ALPHA, 0.2f, 1, 2), SLEEP_LEAF(-0.3f),
+      SLEEP_LEAF(0.7f)),
+  SLEEP_TREE(SLEEP_STAGE_WAKE, SLEEP_NODE(TAT, 10.0f, 1, 2), SLEEP_LEAF(0.0f), SLEEP_LEAF(0.5f)),
+  SLEEP_TREE(SLEEP_STAGE_REM, SLEEP_NODE(REL_THETA, 0.2f, 1, 2), SLEEP_LEAF(-0.6f),
+      SLEEP_NODE(REL_DELTA, 0.4f, 3, 4), SLEEP_LEAF(0.9f), SLEEP_LEAF(-0.3f)),
+  SLEEP_TREE(SLEEP_STAGE_REM, SLEEP_NODE(LOG_PIM, 1.7f, 1, 2), SLEEP_LEAF(0.5f),
+      SLEEP_LEAF(-0.8f)),
+  SLEEP_TREE(SLEEP_STAGE_N1, SLEEP_NODE(REL_THETA, 0.2f, 1, 2), SLEEP_LEAF(-0.3f),
+      SLEEP_NODE(REL_ALPHA, 0.15f, 3, 4), SLEEP_LEAF(0.6f), SLEEP_LEAF(0.3f)),
+  SLEEP_TREE(SLEEP_STAGE_N1, SLEEP_NODE(LOG_PIM, 2.0f, 1, 2), SLEEP_LEAF(0.2f),
+      SLEEP_LEAF(-0.5f)),
+  SLEEP_TREE(SLEEP_STAGE_N2, SLEEP_NODE(REL_SIGMA, 0.12f, 1, 2), SLEEP_LEAF(-0.5f),
+      SLEEP_NODE(REL_DELTA, 0.5f, 3, 4), SLEEP_LEAF(1.2f), SLEEP_LEAF(0.4f)),
+  SLEEP_TREE(SLEEP_STAGE_N2, SLEEP_NODE(REL_DELTA, 0.25f, 1, 2), SLEEP_LEAF(-0.4f),
+      SLEEP_NODE(LOG_PIM, 1.8f, 3, 4), SLEEP_LEAF(0.4f), SLEEP_LEAF(-1.0f)),
+  SLEEP_TREE(SLEEP_STAGE_N3, SLEEP_NODE(REL_DELTA, 0.5f, 1, 2), SLEEP_LEAF(-1.0f),
+      SLEEP_NODE(LOG_POWER, 2.5f, 3, 4), SLEEP_LEAF(0.3f), SLEEP_LEAF(1.8f)),
+  SLEEP_TREE(SLEEP_STAGE_N3, SLEEP_NODE(LOG_PIM, 1.8f, 1, 2), SLEEP_LEAF(0.2f),
+      SLEEP_LEAF(-1.5f)),
+};
+
+const s_sleepModel sleep_stage_placeholder = {placeholder,
+  sizeof(placeholder)/sizeof(placeholder[0])};
+#endif
+
+/* Children pointing forward inside the table guarantee that evaluation ends in a leaf. */
+static bool tree_valid(const s_sleepTree *tree){
+  if(tree->stage <= SLEEP_STAGE_UNKNOWN || tree->stage >= SLEEP_STAGES || tree->nodes == 0 ||
+      tree->node == NULL)
+    return false;
+  for(uint8_t i=0; i<tree->nodes; ++i){
+    const s_sleepTreeNode *node = &tree->node[i];
+
+    if(node->feature == SLEEP_NODE_LEAF) continue;
+    if(node->feature < 0 || node->feature >= SLEEP_FEATURES || node->left <= i ||
+        node->right <= i || node->left >= tree->nodes || node->right >= tree->nodes)
+      return false;
+  }
+  return true;
+}
+
+static float tree_eval(const s_sleepTree *tree, const float *feature){
+  const s_sleepTreeNode *node = &tree->node[0];
+
+  while(node->feature != SLEEP_NODE_LEAF)
+    node = &tree->node[feature[node->feature] < node->value ? node->left : node->right];
+  return node->value;
+}
+
+static void epoch_clear(s_sleepStager *stager){
+  memset(stager->power, 0, sizeof(stager->power));
+  memset(stager->bad, 0, sizeof(stager->bad));
+  stager->hops = 0;
+  stager->quality_epochs = 0;
+}
+
+bool sleep_stage_init(s_sleepStager *stager, const s_sleepModel *model){
+  if(model == NULL || model->tree == NULL || model->trees == 0) return false;
+  for(size_t t=0; t<model->trees; ++t)
+    if(!tree_valid(&model->tree[t])) return false;
+
+  memset(stager, 0, sizeof(s_sleepStager));
+  stager->model = model;
+  stager->previous = SLEEP_STAGE_UNKNOWN;
+  return true;
+}
+
+void sleep_stage_add_band_power(s_sleepStager *stager, const s_bandPower *power, size_t count){
+  for(size_t i=0; i<count; ++i)
+    for(int b=0; b<EEG_BANDS; ++b)
+      for(int ch=0; ch<EEG_CHANNELS; ++ch)
+        stager->power[b][ch] += power[i].power[b][ch];
+  stager->hops += (uint32_t)count;
+}
+
+void sleep_stage_add_quality(s_sleepStager *stager, const s_eegQuality *quality, size_t count){
+  for(size_t i=0; i<count; ++i)
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      if(quality[i].bad & (1u << ch)) ++stager->bad[ch];
+  stager->quality_epochs += (uint16_t)count;
+}
+
+/* Returns bitmask of channels good in at least half of the epoch. */
+static uint8_t good_channels(const s_sleepStager *stager){
+  uint8_t mask = 0;
+
+  for(int ch=0; ch<EEG_CHANNELS; ++ch)
+    if(2u*stager->bad[ch] <= stager->quality_epochs) mask |= (uint8_t)(1u << ch);
+  return stager->hops ? mask : 0;
+}
+
+static void features(const s_sleepStager *stager, uint8_t channels,
+    const s_actigraphyEpoch *activity, float *feature){
+  float band[EEG_BANDS] = {0};
+  float total = 0;
+
+  for(int b=0; b<EEG_BANDS; ++b){
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      if(channels & (1u << ch)) band[b] += stager->power[b][ch];
+    total += band[b];
+  }
+  total = total > POWER_FLOOR ? total : POWER_FLOOR;
+  feature[SLEEP_FEATURE_LOG_POWER] =
+      log10f(total/(stager->hops*(float)__builtin_popcount(channels)));
+  for(int b=0; b<EEG_BANDS; ++b)
+    feature[SLEEP_FEATURE_REL_DELTA + b] = band[b]/total;
+  feature[SLEEP_FEATURE_LOG_PIM] = activity ? log10f(1.0f + activity->pim) : 0;
+  feature[SLEEP_FEATURE_TAT] = activity ? activity->tat : 0;
+}
+
+e_sleepStage sleep_stage_epoch(s_sleepStager *stager, const s_actigraphyEpoch *activity,
+    s_sleepEpoch *out){
+  float feature[SLEEP_FEATURES] = {0};
+  float score[SLEEP_STAGES] = {0};
+  uint8_t channels = good_channels(stager);
+  e_sleepStage stage = SLEEP_STAGE_UNKNOWN;
+  float confidence = 0;
+
+  if(channels){
+    float sum = 0;
+
+    features(stager, channels, activity, feature);
+    for(size_t t=0; t<stager->model->trees; ++t)
+      score[stager->model->tree[t].stage] += tree_eval(&stager->model->tree[t], feature);
+    if(stager->previous != SLEEP_STAGE_UNKNOWN)
+      score[stager->previous] += STICKY;
+
+    stage = SLEEP_STAGE_WAKE;
+    for(int s=SLEEP_STAGE_WAKE; s<SLEEP_STAGES; ++s)
+      if(score[s] > score[stage]) stage = (e_sleepStage)s;
+    for(int s=SLEEP_STAGE_WAKE; s<SLEEP_STAGES; ++s)
+      sum += expf(score[s] - score[stage]);
+    confidence = 1.0f/sum;
+  }
+
+  if(out){
+    out->index = stager->index;
+    out->stage = stage;
+    out->confidence = confidence;
+    out->channels = channels;
+    memcpy(out->feature, feature, sizeof(feature));
+  }
+  ++stager->index;
+  stager->previous = stage;
+  epoch_clear(stager);
+  return stage;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file    ic_spo2.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming SpO2 and heart rate estimation from AFE4400 IR/red samples
+ *
+ * Pulse signal is DC - sample (more blood absorbs more light), smoothed by two one-pole low-pass
+ * stages. Beat is the maximum of a segment after the signal fell from it by a part of the segment
+ * swing; extremes of both channels over the same segment give AC amplitudes.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_spo2.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define DC_TAU          1.5f    // DC tracking time constant [s]
+#define AC_CUTOFF       5.0f    // pulse smoothing cut-off [Hz]
+#define MIN_INTERVAL    0.3f    // [s], 200 bpm
+#define MAX_INTERVAL    2.5f    // [s], 24 bpm
+#define MIN_RATIO       0.6f    // minimal beat interval in median intervals
+#define FALL_RATIO      0.4f    // fall from segment maximum (part of swing) which confirms beat
+#define MIN_SWING_RATIO 0.6f    // minimal swing in running beat amplitudes
+#define IRREGULARITY    0.3f    // maximal (longest - shortest)/median interval
+#define ADC_SATURATION  2055000 // 98% of 22 bit ADC range
+
+static float median(const float *value, uint8_t count){
+  float v[SPO2_BEATS];
+
+  memcpy(v, value, count*sizeof(float));
+  for(uint8_t i=1; i<count; ++i){
+    float t = v[i];
+    int8_t j = i - 1;
+    while(j >= 0 && v[j] > t){
+      v[j+1] = v[j];
+      --j;
+    }
+    v[j+1] = t;
+  }
+  return v[count/2];
+}
+
+void spo2_default_config(s_spo2Config *config, float sample_rate){
+  config->sample_rate = sample_rate;
+  config->cal_a = 110.0f;
+  config->cal_b = 25.0f;
+  config->min_dc = 10000.0f;
+  config->min_perfusion = 0.0005f;
+}
+
+void spo2_init(s_spo2State *state, const s_spo2Config *config){
+  memset(state, 0, sizeof(s_spo2State));
+  state->config = *config;
+  state->dc_alpha = 1.0f - expf(-1.0f/(config->sample_rate*DC_TAU));
+  state->ac_alpha = 1.0f - expf(-2.0f*(float)M_PI*AC_CUTOFF/config->sample_rate);
+  state->refractory = (uint32_t)(MIN_INTERVAL*config->sample_rate);
+  state->max_interval = (uint32_t)(MAX_INTERVAL*config->sample_rate);
+  state->result.quality = SPO2_QUALITY_NO_PULSE | SPO2_QUALITY_SETTLING;
+}
+
+static void segment_restart(s_spo2State *state){
+  state->seg_max = state->seg_min = state->ir2;
+  state->red_max = state->red_min = state->red2;
+  state->seg_max_at = state->now;
+}
+
+static void beat(s_spo2State *state){
+  float swing = state->seg_max - state->seg_min;
+  float ac_ir = swing/state->dc_ir;
+  float ac_red = (state->red_max - state->red_min)/state->dc_red;
+  uint32_t interval = state->seg_max_at - state->last_beat;
+
+  if(state->result.beats && interval <= state->max_interval){
+    state->interval[state->next] = (float)interval;
+    state->ratio[state->next] = ac_red/ac_ir;
+    state->next = (state->next + 1)%SPO2_BEATS;
+    if(state->no_of_beats < SPO2_BEATS) ++state->no_of_beats;
+  }
+  /* fast attack, slow decay - dicrotic waves must not pull threshold down */
+  state->amplitude = swing > state->amplitude ? swing : 0.9f*state->amplitude + 0.1f*swing;
+  state->result.perfusion = 100.0f*ac_ir;
+  state->last_beat = state->seg_max_at;
+  ++state->result.beats;
+}
+
+static void update_result(s_spo2State *state){
+  s_spo2Result *res = &state->result;
+  uint8_t quality = 0;
+
+  if(state->dc_ir < state->config.min_dc || state->dc_red < state->config.min_dc ||
+      state->saturated)
+    quality |= SPO2_QUALITY_NO_CONTACT;
+  if(res->perfusion < 100.0f*state->config.min_perfusion)
+    quality |= SPO2_QUALITY_LOW_PERFUSION;
+  if(res->beats == 0 || state->now - state->last_beat > state->max_interval)
+    quality |= SPO2_QUALITY_NO_PULSE;
+  if(state->no_of_beats < SPO2_BEATS)
+    quality |= SPO2_QUALITY_SETTLING;
+
+  if(state->no_of_beats){
+    float med = median(state->interval, state->no_of_beats);
+    float lo = med, hi = med;
+    float spo2 = state->config.cal_a - state->config.cal_b*median(state->ratio, state->no_of_beats);
+
+    for(uint8_t i=0; i<state->no_of_beats; ++i){
+      if(state->interval[i] < lo) lo = state->interval[i];
+      if(state->interval[i] > hi) hi = state->interval[i];
+    }
+    if(hi - lo > IRREGULARITY*med)
+      quality |= SPO2_QUALITY_IRREGULAR;
+    state->median_interval = med;
+    res->heart_rate = 60.0f*state->config.sample_rate/med;
+    res->spo2 = spo2 > 100.0f ? 100.0f : (spo2 < 0 ? 0 : spo2);
+  }
+  res->quality = quality;
+}
+
+void spo2_process(s_spo2State *state, const int32_t *ir, const int32_t *red, size_t count,
+    s_spo2Result *result){
+  state->saturated = false;
+
+  uint32_t refractory = state->refractory;
+
+  /* beats can't come much faster than median, so dicrotic waves are never beats */
+  if(state->no_of_beats == SPO2_BEATS && MIN_RATIO*state->median_interval > refractory)
+    refractory = (uint32_t)(MIN_RATIO*state->median_interval);
+
+  for(size_t n=0; n<count; ++n){
+    float x_ir = (float)ir[n], x_red = (float)red[n];
+    float min_swing;
+
+    if(ir[n] > ADC_SATURATION || ir[n] < -ADC_SATURATION ||
+        red[n] > ADC_SATURATION || red[n] < -ADC_SATURATION)
+      state->saturated = true;
+    if(state->now == 0){
+      state->dc_ir = x_ir;
+      state->dc_red = x_red;
+    }
+    state->dc_ir += (x_ir - state->dc_ir)*state->dc_alpha;
+    state->dc_red += (x_red - state->dc_red)*state->dc_alpha;
+
+    state->ir1 += (state->dc_ir - x_ir - state->ir1)*state->ac_alpha;
+    state->ir2 += (state->ir1 - state->ir2)*state->ac_alpha;
+    state->red1 += (state->dc_red - x_red - state->red1)*state->ac_alpha;
+    state->red2 += (state->red1 - state->red2)*state->ac_alpha;
+
+    if(state->ir2 > state->seg_max){
+      state->seg_max = state->ir2;
+      state->seg_max_at = state->now;
+    }
+    if(state->ir2 < state->seg_min) state->seg_min = state->ir2;
+    if(state->red2 > state->red_max) state->red_max = state->red2;
+    if(state->red2 < state->red_min) state->red_min = state->red2;
+
+    min_swing = MIN_SWING_RATIO*state->amplitude;
+    if(min_swing < 0.5f*state->config.min_perfusion*state->dc_ir)
+      min_swing = 0.5f*state->config.min_perfusion*state->dc_ir;
+
+    if(state->seg_max - state->seg_min > min_swing &&
+        state->seg_max - state->ir2 > FALL_RATIO*(state->seg_max - state->seg_min) &&
+        (state->result.beats == 0 || state->seg_max_at - state->last_beat >= refractory)){
+      beat(state);
+      ++state->now;
+      segment_restart(state);
+      continue;
+    }
+    if(state->now - state->seg_max_at > state->max_interval){
+      /* lost pulse - forget amplitude so smaller pulses are found again */
+      state->amplitude *= 0.5f;
+      segment_restart(state);
+    }
+    ++state->now;
+  }
+
+  update_result(state);
+  if(result) *result = state->result;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file    ic_status_store.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Device status store
+ *
+ * Sequence is odd while writer updates data. Data words are accessed with relaxed atomics, so
+ * torn reads are only possible in retried iterations.
+ */
+
+#include "ic_status_store.h"
+#include "ic_frame_constructor.h"
+
+static void words_load(const s_statusStore *store, uint32_t *words){
+  for(size_t i=0; i<STATUS_STORE_WORDS; ++i)
+    words[i] = __atomic_load_n(&store->data[i], __ATOMIC_RELAXED);
+}
+
+static void words_store(s_statusStore *store, const uint32_t *words){
+  for(size_t i=0; i<STATUS_STORE_WORDS; ++i)
+    __atomic_store_n(&store->data[i], words[i], __ATOMIC_RELAXED);
+}
+
+static uint16_t changed_fields(const s_statusSnapshot *prev, const s_statusSnapshot *curr){
+  const uint8_t *p = (const uint8_t *)&prev->devs_func;
+  const uint8_t *c = (const uint8_t *)&curr->devs_func;
+  uint16_t changed = 0;
+
+  for(unsigned int i=0; i<sizeof(s_devsFunc); ++i)
+    if(p[i] != c[i]) changed |= 0x01<<i;
+  if(prev->active_data_streams != curr->active_data_streams)
+    changed |= STATUS_CHANGE_DATA_STREAMS;
+  return changed;
+}
+
+void status_store_init(s_statusStore *store, f_statusChange on_change, void *user){
+  s_statusSnapshot init;
+
+  memset(store, 0, sizeof(s_statusStore));
+  memset(&init, 0, sizeof(init));
+  memset(&init.devs_func, FUN_TYPE_OFF, sizeof(s_devsFunc));
+  memcpy(store->data, &init, sizeof(init));
+  store->on_change = on_change;
+  store->user = user;
+}
+
+uint16_t status_store_publish(s_statusStore *store, s_devsFunc devs_func,
+    uint8_t active_data_streams, uint16_t id){
+  uint32_t words[STATUS_STORE_WORDS] = {0};
+  s_statusSnapshot prev, curr;
+  uint32_t seq;
+
+  /* writers serialize on odd sequence */
+  do{
+    seq = __atomic_load_n(&store->seq, __ATOMIC_RELAXED);
+  }while((seq & 1) || !__atomic_compare_exchange_n(&store->seq, &seq, seq+1, true,
+        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  words_load(store, words);
+  memcpy(&prev, words, sizeof(prev));
+
+  memset(&curr, 0, sizeof(curr));
+  curr.id = id;
+  curr.devs_func = devs_func;
+  curr.active_data_streams = active_data_streams;
+  memcpy(words, &curr, sizeof(curr));
+  words_store(store, words);
+
+  __atomic_store_n(&store->seq, seq+2, __ATOMIC_RELEASE);
+
+  uint16_t changed = changed_fields(&prev, &curr);
+  if(changed && store->on_change)
+    store->on_change(&prev, &curr, changed, store->user);
+  return changed;
+}
+
+bool status_store_publish_frame(s_statusStore *store, char *rsp_frame){
+  s_statusRsp *rsp = &CAST_AR(rsp_frame)->frame.payload.status_rsp;
+  uint8_t active_data_streams;
+
+  if(!neuroon_cmd_frame_validate((uint8_t *)rsp_frame, FRAME_SIZE)) return false;
+  if(CAST_AR(rsp_frame)->frame.cmd != RESP(STATUS_CMD)) return false;
+
+  memcpy(&active_data_streams, &rsp->active_data_stream, sizeof(active_data_streams));
+  status_store_publish(store, rsp->devs_func, active_data_streams, rsp->id);
+  return true;
+}
+
+uint32_t status_store_snapshot(const s_statusStore *store, s_statusSnapshot *snapshot){
+  uint32_t words[STATUS_STORE_WORDS];
+  uint32_t seq0, seq1;
+
+  do{
+    seq0 = __atomic_load_n(&store->seq, __ATOMIC_ACQUIRE);
+    if(seq0 & 1) continue;
+    words_load(store, words);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    seq1 = __atomic_load_n(&store->seq, __ATOMIC_RELAXED);
+    if(seq0 == seq1) break;
+  }while(true);
+
+  memcpy(snapshot, words, sizeof(s_statusSnapshot));
+  return seq0>>1;
+}
+
+uint32_t status_store_version(const s_statusStore *store){
+  return __atomic_load_n(&store->seq, __ATOMIC_ACQUIRE)>>1;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file    ic_stimulation.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Closed-loop stimulation fast path (slow oscillation phase to light/vibration frames)
+ *
+ * Phase grows linearly from the last zero crossing with frequency of the last full cycles, which
+ * is enough for the narrow slow oscillation band and needs no per-sample trigonometry; band-pass
+ * phase response is evaluated only when frequency estimate changes.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "ic_biquad.h"
+#include "ic_frame_constructor.h"
+#include "ic_stimulation.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define TWO_PI      (2.0f*(float)M_PI)
+#define NEVER       UINT32_MAX
+#define PERIOD_EMA  0.5f    // weight of the newest cycle in period estimate
+#define STALE       1.5f    // periods without rising crossing after which oscillation is lost
+#define BATCH_EMA   0.25f   // weight of the newest interval in mean interval between batches
+
+/* a is after b, sample counters wrap */
+#define AFTER(a, b) ((int32_t)((a) - (b)) > 0)
+
+void stim_default_config(s_stimConfig *config, float sample_rate){
+  config->sample_rate = sample_rate;
+  config->low = 0.5f;
+  config->high = 2.0f;
+  config->target_phase = (float)M_PI/2;
+  config->lead_us = 30000.0f;
+  config->min_amplitude = 75.0f;
+  config->refractory_us = 2500000;
+}
+
+static void set_section(s_stimulator *stim, int k, const s_biquadCoef *coef){
+  stim->b0[k] = coef->b0;
+  stim->b1[k] = coef->b1;
+  stim->b2[k] = coef->b2;
+  stim->a1[k] = coef->a1;
+  stim->a2[k] = coef->a2;
+}
+
+bool stim_init(s_stimulator *stim, const s_stimConfig *config, s_asyncTransport *transport,
+    f_stimClock clock, void *clock_user){
+  s_biquadCoef coef;
+
+  memset(stim, 0, sizeof(s_stimulator));
+  if(transport == NULL || clock == NULL || config->sample_rate <= 0) return false;
+  if(config->low <= 0 || config->high <= config->low || config->high >= config->sample_rate/2)
+    return false;
+
+  stim->config = *config;
+  biquad_highpass(&coef, config->sample_rate, config->low, biquad_butterworth_q(2, 0));
+  set_section(stim, 0, &coef);
+  biquad_lowpass(&coef, config->sample_rate, config->high, biquad_butterworth_q(2, 0));
+  set_section(stim, 1, &coef);
+  stim->min_period = config->sample_rate/config->high;
+  stim->max_period = config->sample_rate/config->low;
+  stim->rise_at = stim->fall_at = NEVER;
+  stim->last_fired = NEVER;
+  stim->uuid = ERROR_UUID;
+  stim->transport = transport;
+  stim->clock = clock;
+  stim->clock_user = clock_user;
+  return true;
+}
+
+static bool prepared(s_stimulator *stim, uint16_t first_id, uint16_t no_of_ids){
+  if(stim->uuid == ERROR_UUID || no_of_ids == 0){
+    stim->uuid = ERROR_UUID;
+    return false;
+  }
+  stim->first_id = first_id;
+  stim->no_of_ids = no_of_ids;
+  stim->next_id = 0;
+  return true;
+}
+
+bool stim_prepare_light(s_stimulator *stim, e_rgbLedSide side, e_funcType func,
+    e_rgbLedColor color, uint8_t intensity, uint32_t duration, uint16_t period, uint16_t first_id,
+    uint16_t no_of_ids){
+  stim->len = NUC_FRAME_SIZE;
+  stim->uuid = rgb_led_set_func(stim->frame, &stim->len, side, func, color, intensity, duration,
+      period, first_id);
+  return prepared(stim, first_id, no_of_ids);
+}
+
+bool stim_prepare_vibration(s_stimulator *stim, e_funcType func, uint8_t intensity,
+    uint32_t duration, uint16_t period, uint16_t first_id, uint16_t no_of_ids){
+  stim->len = NUC_FRAME_SIZE;
+  stim->uuid = vibrator_set_func(stim->frame, &stim->len, func, intensity, duration, period,
+      first_id);
+  return prepared(stim, first_id, no_of_ids);
+}
+
+/* Phase lag [rad] of the band-pass at w [rad/sample]. */
+static float band_pass_lag(const s_stimulator *stim, float w){
+  float c1 = cosf(w), s1 = sinf(w), c2 = cosf(2*w), s2 = sinf(2*w);
+  float lag = 0;
+
+  for(int k=0; k<STIM_SECTIONS; ++k){
+    float num_re = stim->b0[k] + stim->b1[k]*c1 + stim->b2[k]*c2;
+    float num_im = -stim->b1[k]*s1 - stim->b2[k]*s2;
+    float den_re = 1.0f + stim->a1[k]*c1 + stim->a2[k]*c2;
+    float den_im = -stim->a1[k]*s1 - stim->a2[k]*s2;
+    lag -= atan2f(num_im, num_re) - atan2f(den_im, den_re);
+  }
+  return lag;
+}
+
+static void rising_crossing(s_stimulator *stim){
+  if(stim->rise_at != NEVER && stim->fall_at != NEVER && AFTER(stim->fall_at, stim->rise_at)){
+    float cycle = (float)(stim->now - stim->rise_at);
+
+    if(cycle >= stim->min_period && cycle <= stim->max_period){
+      stim->period = stim->period > 0 ? PERIOD_EMA*cycle + (1 - PERIOD_EMA)*stim->period : cycle;
+      stim->lag = band_pass_lag(stim, TWO_PI/stim->period);
+      stim->amplitude = stim->peak - stim->trough;
+    }
+    else{
+      stim->period = 0;
+    }
+  }
+  stim->rise_at = stim->now;
+  stim->peak = 0;
+  stim->armed = true;
+}
+
+float stim_phase(const s_stimulator *stim){
+  uint32_t newest = stim->now - 1;
+  float phase;
+
+  if(stim->period <= 0 || stim->rise_at == NEVER) return -1.0f;
+  if(newest - stim->rise_at > STALE*stim->period) return -1.0f;
+
+  if(stim->last >= 0 || stim->fall_at == NEVER || AFTER(stim->rise_at, stim->fall_at))
+    phase = TWO_PI*(newest - stim->rise_at)/stim->period;
+  else
+    phase = (float)M_PI + TWO_PI*(newest - stim->fall_at)/stim->period;
+  phase = fmodf(phase + stim->lag, TWO_PI);
+  return phase < 0 ? phase + TWO_PI : phase;
+}
+
+static bool fire(s_stimulator *stim, uint64_t rx_us){
+  u_cmdFrameContainer *frame = (u_cmdFrameContainer *)stim->frame;
+  uint64_t latency;
+
+  priv_set_cmd_id(frame, (uint16_t)(stim->first_id + stim->next_id));
+  priv_calculate_crc(frame);
+  if(!stim->transport->send(stim->transport, stim->uuid, stim->frame, stim->len)){
+    ++stim->stats.send_failed;
+    return false;
+  }
+  latency = stim->clock(stim->clock_user) - rx_us;
+  stim->next_id = (uint16_t)((stim->next_id + 1)%stim->no_of_ids);
+  stim->armed = false;
+  stim->last_fired = stim->now;
+  ++stim->stats.fired;
+  stim->stats.last_latency_us = latency;
+  stim->stats.sum_latency_us += latency;
+  if(latency > stim->stats.max_latency_us) stim->stats.max_latency_us = latency;
+  return true;
+}
+
+bool stim_process(s_stimulator *stim, const float *sample, size_t count, uint64_t rx_us){
+  const s_stimConfig *cfg = &stim->config;
+  float us_per_sample = 1e6f/cfg->sample_rate;
+  float phase, to_target;
+
+  if(count){
+    /* batches come in connection events of varying size - expect the next one after the mean
+     * interval, the first one after as many samples as this batch has */
+    if(stim->batch_us > 0)
+      stim->batch_us += BATCH_EMA*((float)(rx_us - stim->last_rx_us) - stim->batch_us);
+    else if(stim->now)
+      stim->batch_us = (float)(rx_us - stim->last_rx_us);
+    stim->last_rx_us = rx_us;
+  }
+
+  for(size_t n=0; n<count; ++n){
+    float x = sample[n];
+
+    for(int k=0; k<STIM_SECTIONS; ++k){
+      float y = stim->b0[k]*x + stim->z1[k];
+      stim->z1[k] = stim->b1[k]*x - stim->a1[k]*y + stim->z2[k];
+      stim->z2[k] = stim->b2[k]*x - stim->a2[k]*y;
+      x = y;
+    }
+    if(stim->last < 0 && x >= 0){
+      rising_crossing(stim);
+    }
+    else if(stim->last >= 0 && x < 0){
+      stim->fall_at = stim->now;
+      stim->trough = 0;
+    }
+    if(x >= 0 && x > stim->peak) stim->peak = x;
+    if(x < 0 && x < stim->trough) stim->trough = x;
+    stim->last = x;
+    ++stim->now;
+  }
+
+  if(!count || !stim->armed || stim->uuid == ERROR_UUID || stim->amplitude < cfg->min_amplitude)
+    return false;
+  if(stim->last_fired != NEVER &&
+      (stim->now - stim->last_fired)*us_per_sample < cfg->refractory_us)
+    return false;
+  if((phase = stim_phase(stim)) < 0) return false;
+
+  /* fire now if the next batch would be further from the target than this one */
+  to_target = fmodf(cfg->target_phase - phase + 2*TWO_PI, TWO_PI)/TWO_PI*stim->period*
+      us_per_sample;
+  if(to_target - cfg->lead_us > 0.5f*(stim->batch_us > 0 ? stim->batch_us : count*us_per_sample))
+    return false;
+  return fire(stim, rx_us);
+}
@@ -0,0 +1,154 @@
+/**
+ * @file    ic_stream_decoder.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Batch decoder of data stream frames
+ *
+ * EEG: eight frames give 8x8 int16 matrix (frame x channel) which is transposed with three
+ * stages of interleaving shuffles, so every channel gets eight samples with one vector store.
+ *
+ * Other data: every field of the packed frame starts at 16 bit boundary and frame has five 32 bit
+ * words (ts, ir, red, acc_x|acc_y, acc_z|temp). Four frames are loaded with five unaligned
+ * vector loads and deinterleaved (stride 5) into word columns, 16 and 8 bit fields are extracted
+ * with arithmetic shifts - no unaligned scalar loads of packed fields.
+ */
+
+#include <string.h>
+#include "ic_stream_decoder.h"
+#include "ic_simd.h"
+
+#define EEG_BLOCK 8   // frames transposed at once
+#define OTHER_BLOCK 4 // frames deinterleaved at once
+
+static inline void eeg_time_stamps(const u_eegDataFrameContainter *frames, size_t count,
+    uint32_t *time_stamp){
+  if(time_stamp == NULL) return;
+  for(size_t n=0; n<count; ++n)
+    memcpy(&time_stamp[n], &frames[n].frame.time_stamp, sizeof(uint32_t));
+}
+
+#if IC_SIMD
+
+/* rows: samples of 8 consecutive frames, result: channels */
+static inline void eeg_transpose(v8i16 r[EEG_BLOCK]){
+  SIMD_TRANSPOSE8(v8i16, SIMD_SHUFFLE8X16, r);
+}
+
+static inline void eeg_load_block(const u_eegDataFrameContainter *frames, v8i16 r[EEG_BLOCK]){
+  for(int i=0; i<EEG_BLOCK; ++i)
+    r[i] = SIMD_LOAD(v8i16, frames[i].frame.eeg_data);
+}
+
+/* Gather words {a, a+5, a+10, a+15} of 4 frames loaded into w[0..4]. */
+#define OTHER_COLUMN(w, i0, i1, i2, i3, j0, j1, j2, j3)                  \
+  SIMD_SHUFFLE4X32(SIMD_SHUFFLE4X32((w)[j0], (w)[j1], i0, i1, 0, 0),     \
+      SIMD_SHUFFLE4X32((w)[j2], (w)[j3], i2, i3, 0, 0), 0, 1, 4, 5)
+
+static inline void other_store16(int16_t *column, v4i32 v){
+  if(column) SIMD_STORE(column, __builtin_convertvector(v, v4i16));
+}
+
+static inline void other_store8(int8_t *column, v4i32 v){
+  if(column) SIMD_STORE(column, __builtin_convertvector(v, v4i8));
+}
+
+#endif /* IC_SIMD */
+
+void stream_decode_eeg(const u_eegDataFrameContainter *frames, size_t count,
+    const s_eegColumns *out){
+  size_t n = 0;
+
+  eeg_time_stamps(frames, count, out->time_stamp);
+#if IC_SIMD
+  for(; n + EEG_BLOCK <= count; n += EEG_BLOCK){
+    v8i16 r[EEG_BLOCK];
+    eeg_load_block(&frames[n], r);
+    eeg_transpose(r);
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      SIMD_STORE(&out->channel[ch][n], r[ch]);
+  }
+#endif
+  for(; n<count; ++n){
+    int16_t sample[EEG_CHANNELS];
+    memcpy(sample, frames[n].frame.eeg_data, sizeof(sample));
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      out->channel[ch][n] = sample[ch];
+  }
+}
+
+void stream_decode_eeg_uv(const u_eegDataFrameContainter *frames, size_t count,
+    const s_eegScale *scale, const s_eegColumnsUv *out){
+  size_t n = 0;
+
+  eeg_time_stamps(frames, count, out->time_stamp);
+#if IC_SIMD
+  for(; n + EEG_BLOCK <= count; n += EEG_BLOCK){
+    v8i16 r[EEG_BLOCK];
+    eeg_load_block(&frames[n], r);
+    eeg_transpose(r);
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      v8f32 uv = __builtin_convertvector(r[ch], v8f32);
+      uv = uv*scale->gain[ch] + scale->offset[ch];
+      SIMD_STORE(&out->channel[ch][n], uv);
+    }
+  }
+#endif
+  for(; n<count; ++n){
+    int16_t sample[EEG_CHANNELS];
+    memcpy(sample, frames[n].frame.eeg_data, sizeof(sample));
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      out->channel[ch][n] = (float)sample[ch]*scale->gain[ch] + scale->offset[ch];
+  }
+}
+
+void stream_decode_other(const u_otherDataFrameContainer *frames, size_t count,
+    const s_otherColumns *out){
+  size_t n = 0;
+
+#if IC_SIMD
+  for(; n + OTHER_BLOCK <= count; n += OTHER_BLOCK){
+    const uint8_t *raw = frames[n].raw_data;
+    v4u32 w[5];
+    v4u32 ts, ir, red, acc_xy, acc_z_temp;
+
+    for(int i=0; i<5; ++i)
+      w[i] = SIMD_LOAD(v4u32, raw + i*sizeof(v4u32));
+
+    /* word k of frame f is word 5f+k of the block */
+    ts          = OTHER_COLUMN(w, 0, 5, 2, 7, 0, 1, 2, 3);
+    ir          = OTHER_COLUMN(w, 1, 6, 3, 4, 0, 1, 2, 4);
+    red         = OTHER_COLUMN(w, 2, 7, 0, 5, 0, 1, 3, 4);
+    acc_xy      = OTHER_COLUMN(w, 3, 4, 1, 6, 0, 2, 3, 4);
+    acc_z_temp  = OTHER_COLUMN(w, 0, 5, 2, 7, 1, 2, 3, 4);
+
+    if(out->time_stamp) SIMD_STORE(&out->time_stamp[n], ts);
+    if(out->ir) SIMD_STORE(&out->ir[n], (v4i32)ir);
+    if(out->red) SIMD_STORE(&out->red[n], (v4i32)red);
+    other_store16(out->acc_x ? &out->acc_x[n] : NULL, (v4i32)(acc_xy<<16)>>16);
+    other_store16(out->acc_y ? &out->acc_y[n] : NULL, (v4i32)acc_xy>>16);
+    other_store16(out->acc_z ? &out->acc_z[n] : NULL, (v4i32)(acc_z_temp<<16)>>16);
+    other_store8(out->temp[0] ? &out->temp[0][n] : NULL, (v4i32)(acc_z_temp<<8)>>24);
+    other_store8(out->temp[1] ? &out->temp[1][n] : NULL, (v4i32)acc_z_temp>>24);
+  }
+#endif
+  for(; n<count; ++n){
+    const uint8_t *raw = frames[n].raw_data;
+    uint32_t ts;
+    int32_t ir, red;
+    int16_t acc[3];
+
+    memcpy(&ts, raw, sizeof(ts));
+    memcpy(&ir, raw + 4, sizeof(ir));
+    memcpy(&red, raw + 8, sizeof(red));
+    memcpy(acc, raw + 12, sizeof(acc));
+    if(out->time_stamp) out->time_stamp[n] = ts;
+    if(out->ir) out->ir[n] = ir;
+    if(out->red) out->red[n] = red;
+    if(out->acc_x) out->acc_x[n] = acc[0];
+    if(out->acc_y) out->acc_y[n] = acc[1];
+    if(out->acc_z) out->acc_z[n] = acc[2];
+    if(out->temp[0]) out->temp[0][n] = (int8_t)raw[18];
+    if(out->temp[1]) out->temp[1][n] = (int8_t)raw[19];
+  }
+}
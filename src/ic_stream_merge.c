@@ -0,0 +1,127 @@
+/**
+ * @file    ic_stream_merge.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Streaming merge of data streams onto common time base
+ *
+ * Record times only grow, so every input keeps a cursor which moves forward through its ring
+ * buffer - cost of a record does not depend on rates or buffer depth.
+ */
+
+#include <string.h>
+#include "ic_stream_merge.h"
+
+#define SLOT(n) ((n) & (STREAM_MERGE_DEPTH-1))
+
+void stream_merge_init(s_streamMerge *merge, const s_streamMergeConfig *config){
+  memset(merge, 0, sizeof(s_streamMerge));
+  merge->config = *config;
+  if(merge->config.period_us <= 0) merge->config.period_us = 1;
+}
+
+int stream_merge_add_input(s_streamMerge *merge, uint8_t channels){
+  if(merge->no_of_inputs >= STREAM_MERGE_MAX_INPUTS) return -1;
+  if(channels == 0 || channels > STREAM_MERGE_MAX_CHANNELS) return -1;
+
+  merge->input[merge->no_of_inputs].channels = channels;
+  merge->channels += channels;
+  return merge->no_of_inputs++;
+}
+
+void stream_merge_push(s_streamMerge *merge, int input, const int64_t *time_us,
+    const float *const *column, size_t count){
+  s_mergeInput *in;
+
+  if(input < 0 || input >= merge->no_of_inputs) return;
+  in = &merge->input[input];
+
+  for(size_t n=0; n<count; ++n){
+    uint32_t slot = SLOT(in->head);
+
+    if(in->head && time_us[n] < in->time[SLOT(in->head-1)]){
+      ++merge->late;
+      continue;
+    }
+    if(in->head - in->cursor >= STREAM_MERGE_DEPTH){
+      ++merge->overruns;
+      ++in->cursor;
+    }
+    in->time[slot] = time_us[n];
+    for(uint8_t ch=0; ch<in->channels; ++ch)
+      in->value[slot][ch] = column[ch][n];
+    ++in->head;
+
+    if(!merge->started){
+      /* records on multiples of period, so merges of different masks are aligned */
+      int64_t p = merge->config.period_us;
+      int64_t t = time_us[n];
+      merge->next_us = (t >= 0 ? (t + p - 1)/p : t/p)*p;
+      merge->horizon_us = t;
+      merge->started = true;
+    }
+    if(time_us[n] > merge->horizon_us) merge->horizon_us = time_us[n];
+  }
+}
+
+/* Values of input at time t, returns true if they are stale. */
+static bool input_sample(const s_streamMerge *merge, s_mergeInput *in, int64_t t, float *value){
+  uint32_t s0, s1;
+  int64_t t0, t1;
+
+  if(in->head == 0){
+    memset(value, 0, in->channels*sizeof(float));
+    return true;
+  }
+  while(in->cursor + 1 < in->head && in->time[SLOT(in->cursor+1)] <= t)
+    ++in->cursor;
+
+  s0 = SLOT(in->cursor);
+  t0 = in->time[s0];
+  if(t0 > t || in->cursor + 1 >= in->head){
+    /* before first or after last sample - hold */
+    memcpy(value, in->value[s0], in->channels*sizeof(float));
+    return t0 > t || t - t0 > merge->config.stale_us;
+  }
+
+  s1 = SLOT(in->cursor+1);
+  t1 = in->time[s1];
+  switch(merge->config.interp){
+    case MERGE_NEAREST:
+      memcpy(value, in->value[(t1 - t < t - t0) ? s1 : s0], in->channels*sizeof(float));
+      break;
+    case MERGE_LINEAR:
+      if(t1 > t0){
+        float a = (float)(t - t0)/(float)(t1 - t0);
+        for(uint8_t ch=0; ch<in->channels; ++ch)
+          value[ch] = in->value[s0][ch] + a*(in->value[s1][ch] - in->value[s0][ch]);
+        break;
+      }
+      /* fall through */
+    case MERGE_HOLD:
+    default:
+      memcpy(value, in->value[s0], in->channels*sizeof(float));
+      break;
+  }
+  return t1 - t0 > merge->config.stale_us;
+}
+
+size_t stream_merge_pull(s_streamMerge *merge, s_mergeRecord *record, size_t max){
+  size_t cnt = 0;
+
+  if(!merge->started) return 0;
+  while(cnt < max && merge->next_us + merge->config.latency_us <= merge->horizon_us){
+    s_mergeRecord *rec = &record[cnt++];
+    float *value = rec->value;
+
+    rec->time_us = merge->next_us;
+    rec->stale = 0;
+    for(uint8_t i=0; i<merge->no_of_inputs; ++i){
+      if(input_sample(merge, &merge->input[i], merge->next_us, value))
+        rec->stale |= 0x01u<<i;
+      value += merge->input[i].channels;
+    }
+    merge->next_us += merge->config.period_us;
+  }
+  return cnt;
+}
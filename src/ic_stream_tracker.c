@@ -0,0 +1,96 @@
+/**
+ * @file    ic_stream_tracker.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Time stamp unwrapping, gap and duplicate detection for data streams
+ *
+ * Difference of consecutive raw time stamps is taken modulo 2^32: values in the lower half are
+ * steps forward (including wrap), values in the upper half mean the frame is older than the last
+ * accepted one. A single jump forward by 2^31 or more looks the same, so if late frames keep
+ * coming the tracker follows them instead of dropping the rest of the stream.
+ */
+
+#include <string.h>
+#include "ic_stream_tracker.h"
+
+#define HALF_RANGE 0x80000000u
+
+void stream_tracker_init(s_streamTracker *tracker, uint32_t step, uint32_t tolerance,
+    uint32_t samples_per_frame){
+  memset(tracker, 0, sizeof(s_streamTracker));
+  tracker->step = step;
+  tracker->tolerance = tolerance;
+  tracker->samples_per_frame = samples_per_frame;
+}
+
+size_t stream_tracker_process(s_streamTracker *tracker, const uint32_t *time_stamp, size_t count,
+    uint32_t *index, uint64_t *unwrapped, s_streamGap *gaps, size_t max_gaps, size_t *no_gaps){
+  uint32_t last = tracker->last;
+  uint64_t last_unwrapped = tracker->last_unwrapped;
+  uint32_t gap_limit = tracker->step + tracker->tolerance;
+  size_t accepted = 0;
+  size_t gap_cnt = 0;
+  size_t n = 0;
+
+  if(!tracker->started && count){
+    last = time_stamp[0];
+    last_unwrapped = time_stamp[0];
+    tracker->started = true;
+    if(index) index[0] = 0;
+    if(unwrapped) unwrapped[0] = last_unwrapped;
+    accepted = n = 1;
+  }
+
+  for(; n<count; ++n){
+    uint32_t delta = time_stamp[n] - last;
+
+    if(delta == 0){
+      ++tracker->stats.duplicates;
+      continue;
+    }
+    if(delta >= HALF_RANGE && ++tracker->late_run < STREAM_TRACKER_RESYNC){
+      ++tracker->stats.late;
+      continue;
+    }
+
+    last = time_stamp[n];
+    last_unwrapped += delta;
+
+    if(tracker->late_run >= STREAM_TRACKER_RESYNC){
+      ++tracker->stats.resyncs;
+    }else if(tracker->step && delta > gap_limit){
+      uint32_t lost = (delta + tracker->step/2)/tracker->step - 1;
+      if(lost){
+        ++tracker->stats.gaps;
+        tracker->stats.lost_frames += lost;
+        if(gaps && gap_cnt < max_gaps){
+          gaps[gap_cnt].index = accepted;
+          gaps[gap_cnt].time_stamp = last_unwrapped;
+          gaps[gap_cnt].lost_frames = lost;
+          gaps[gap_cnt].lost_samples = (uint64_t)lost*tracker->samples_per_frame;
+          ++gap_cnt;
+        }
+      }
+    }
+
+    tracker->late_run = 0;
+    if(index) index[accepted] = (uint32_t)n;
+    if(unwrapped) unwrapped[accepted] = last_unwrapped;
+    ++accepted;
+  }
+
+  tracker->last = last;
+  tracker->last_unwrapped = last_unwrapped;
+  tracker->stats.frames += count;
+  tracker->stats.accepted += accepted;
+  if(no_gaps) *no_gaps = gap_cnt;
+  return accepted;
+}
+
+uint32_t stream_tracker_loss_permille(const s_streamTracker *tracker){
+  uint64_t expected = tracker->stats.accepted + tracker->stats.lost_frames;
+
+  if(expected == 0) return 0;
+  return (uint32_t)(tracker->stats.lost_frames*1000/expected);
+}
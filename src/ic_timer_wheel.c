@@ -0,0 +1,157 @@
+/**
+ * @file    ic_timer_wheel.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Hierarchical timing wheel
+ *
+ * Every level covers 64 times more ticks than previous one. Timers are put into level which
+ * fits their distance from current tick and cascaded down when lower level wraps.
+ */
+
+#include "ic_timer_wheel.h"
+
+#define SLOT_MASK (TIMER_WHEEL_SLOTS-1)
+#define LEVEL_INDEX(tick, level) (((tick)>>((level)*TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK)
+#define WHEEL_RANGE (1ull<<(TIMER_WHEEL_LEVELS*TIMER_WHEEL_SLOT_BITS))
+
+static void list_init(s_twNode *head){
+  head->next = head;
+  head->prev = head;
+}
+
+static void list_append(s_twNode *head, s_twNode *node){
+  node->next = head;
+  node->prev = head->prev;
+  head->prev->next = node;
+  head->prev = node;
+}
+
+static void list_unlink(s_twNode *node){
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+  node->next = NULL;
+  node->prev = NULL;
+}
+
+/* Move whole list to other (empty) head. */
+static void list_splice(s_twNode *from, s_twNode *to){
+  if(from->next == from){
+    list_init(to);
+    return;
+  }
+  to->next = from->next;
+  to->prev = from->prev;
+  to->next->prev = to;
+  to->prev->next = to;
+  list_init(from);
+}
+
+static void internal_add(s_timerWheel *tw, s_twNode *node){
+  uint64_t expires = node->expires;
+  uint64_t delta;
+  s_twNode *head;
+
+  if(expires < tw->now) expires = tw->now;
+  delta = expires - tw->now;
+
+  if(delta >= WHEEL_RANGE){
+    head = &tw->overflow;
+  }else{
+    unsigned int level = 0;
+    while(delta >= (1ull<<((level+1)*TIMER_WHEEL_SLOT_BITS))) ++level;
+    head = &tw->slot[level][LEVEL_INDEX(expires, level)];
+  }
+  list_append(head, node);
+}
+
+/* Re-add all timers from given slot, they will land on lower levels. Returns slot index. */
+static unsigned int cascade(s_timerWheel *tw, unsigned int level){
+  unsigned int index = LEVEL_INDEX(tw->now, level);
+  s_twNode list;
+
+  list_splice(&tw->slot[level][index], &list);
+  while(list.next != &list){
+    s_twNode *node = list.next;
+    list_unlink(node);
+    internal_add(tw, node);
+  }
+  return index;
+}
+
+static void cascade_overflow(s_timerWheel *tw){
+  s_twNode list;
+
+  list_splice(&tw->overflow, &list);
+  while(list.next != &list){
+    s_twNode *node = list.next;
+    list_unlink(node);
+    internal_add(tw, node);
+  }
+}
+
+void timer_wheel_init(s_timerWheel *tw, uint64_t now){
+  for(unsigned int l=0; l<TIMER_WHEEL_LEVELS; ++l)
+    for(unsigned int s=0; s<TIMER_WHEEL_SLOTS; ++s)
+      list_init(&tw->slot[l][s]);
+  list_init(&tw->overflow);
+  tw->now = now;
+  tw->pending = 0;
+}
+
+void timer_wheel_node_init(s_twNode *node){
+  node->next = NULL;
+  node->prev = NULL;
+  node->expires = 0;
+}
+
+void timer_wheel_add(s_timerWheel *tw, s_twNode *node, uint64_t expires){
+  if(timer_wheel_pending(node))
+    list_unlink(node);
+  else
+    ++tw->pending;
+  node->expires = expires;
+  internal_add(tw, node);
+}
+
+bool timer_wheel_del(s_timerWheel *tw, s_twNode *node){
+  if(!timer_wheel_pending(node)) return false;
+  list_unlink(node);
+  --tw->pending;
+  return true;
+}
+
+bool timer_wheel_pending(const s_twNode *node){
+  return node->next != NULL;
+}
+
+size_t timer_wheel_advance(s_timerWheel *tw, uint64_t now, f_timerWheelExpire expire, void *user){
+  size_t cnt = 0;
+
+  while(tw->now <= now){
+    if(tw->pending == 0){
+      tw->now = now + 1;
+      break;
+    }
+
+    unsigned int index = LEVEL_INDEX(tw->now, 0);
+    if(index == 0){
+      unsigned int level = 1;
+      while(level < TIMER_WHEEL_LEVELS && cascade(tw, level) == 0) ++level;
+      if(level == TIMER_WHEEL_LEVELS) cascade_overflow(tw);
+    }
+
+    s_twNode list;
+    list_splice(&tw->slot[0][index], &list);
+    ++tw->now;
+
+    while(list.next != &list){
+      s_twNode *node = list.next;
+      list_unlink(node);
+      --tw->pending;
+      ++cnt;
+      expire(node, user);
+    }
+  }
+  return cnt;
+}
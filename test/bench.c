@@ -0,0 +1,250 @@
+/**
+ * @file    bench.c
+ * @author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @author  Wojtek Weclewski <w.weclewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   Throughput benchmarks of signal processing modules (single core)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ic_actigraphy.h"
+#include "ic_band_power.h"
+#include "ic_decimator.h"
+#include "ic_eeg_filter.h"
+#include "ic_eeg_quality.h"
+#include "ic_sleep_events.h"
+#include "ic_spo2.h"
+
+#define SAMPLE_RATE   250
+#define BENCH_SAMPLES (SAMPLE_RATE*60)    // one minute of EEG
+#define BENCH_SECONDS 0.5                 // minimal run time of every benchmark
+#define PPG_RATE      100                 // AFE4400 sample rate
+#define PPG_SAMPLES   (PPG_RATE*60)       // one minute of IR/red
+
+static float eeg[EEG_CHANNELS][BENCH_SAMPLES];
+static int16_t acc[3][BENCH_SAMPLES];
+static int32_t ppg_ir[PPG_SAMPLES], ppg_red[PPG_SAMPLES];
+
+static double now_sec(void){
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static void eeg_fill(void){
+  srand(1);
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+    for(size_t n=0; n<BENCH_SAMPLES; ++n)
+      eeg[ch][n] = 40.0f*sinf(0.07f*n + ch) + (rand()%2001 - 1000)/100.0f;
+}
+
+static void acc_fill(void){
+  srand(2);
+  for(size_t axis=0; axis<3; ++axis)
+    for(size_t n=0; n<BENCH_SAMPLES; ++n)
+      acc[axis][n] = (int16_t)(2000.0f*sinf(0.01f*n*(axis + 1)) + rand()%201 - 100);
+}
+
+/* 66 bpm pulse with dicrotic harmonic and ADC noise, red modulated to about 97 %. */
+static void ppg_fill(void){
+  srand(3);
+  for(size_t n=0; n<PPG_SAMPLES; ++n){
+    float phase = 2*3.14159265f*1.1f*n/PPG_RATE;
+    float pulse = sinf(phase) + 0.3f*sinf(2*phase + 1);
+
+    ppg_ir[n] = 120000 + (int32_t)(1200*pulse) + rand()%41 - 20;
+    ppg_red[n] = 90000 + (int32_t)(470*pulse) + rand()%41 - 20;
+  }
+}
+
+/* Prints throughput of channel samples (one sample of one channel) per second. */
+static void report(const char *name, double samples, double seconds){
+  printf("%-36s %10.1f M samples/s\n", name, samples/seconds/1e6);
+}
+
+static void bench_eeg_filter(void){
+  static float filtered[EEG_CHANNELS][BENCH_SAMPLES];
+  s_eegFilterSpec spec = {SAMPLE_RATE, 50, 30, false, 0.5f, 35, 4};
+  s_eegFilter filter;
+  s_eegFilterState state;
+  float *channel[EEG_CHANNELS];
+  double start, elapsed;
+  size_t runs = 0;
+
+  eeg_filter_design(&filter, &spec);
+  eeg_filter_reset(&state);
+  /* filter works in place - keep shared signal intact for other benchmarks */
+  memcpy(filtered, eeg, sizeof(filtered));
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+    channel[ch] = filtered[ch];
+
+  start = now_sec();
+  do{
+    eeg_filter_process(&filter, &state, channel, BENCH_SAMPLES);
+    ++runs;
+    elapsed = now_sec() - start;
+  }while(elapsed < BENCH_SECONDS);
+  report("eeg_filter (notch + 4th order bp)", (double)runs*BENCH_SAMPLES*EEG_CHANNELS, elapsed);
+}
+
+static void bench_band_power(void){
+  static s_bandPowerPlan plan;
+  static s_bandPowerState state;
+  static s_bandPower out[BENCH_SAMPLES/(SAMPLE_RATE/2) + 1];
+  s_bandPowerSpec spec;
+  const float *channel[EEG_CHANNELS];
+  double start, elapsed;
+  size_t runs = 0;
+
+  band_power_default_spec(&spec, SAMPLE_RATE, 2*SAMPLE_RATE, SAMPLE_RATE/2);
+  band_power_plan(&plan, &spec);
+  band_power_reset(&state);
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+    channel[ch] = eeg[ch];
+
+  start = now_sec();
+  do{
+    band_power_process(&plan, &state, channel, BENCH_SAMPLES, out);
+    ++runs;
+    elapsed = now_sec() - start;
+  }while(elapsed < BENCH_SECONDS);
+  report("band_power (2 s window, 0.5 s hop)", (double)runs*BENCH_SAMPLES*EEG_CHANNELS, elapsed);
+}
+
+static void bench_decimator(void){
+  static s_decimator dec;
+  static s_decimatorState state;
+  static float y[EEG_CHANNELS][BENCH_SAMPLES*2/5 + 1];
+  s_decimatorSpec spec;
+  const float *in[EEG_CHANNELS];
+  float *out[EEG_CHANNELS];
+  double start, elapsed;
+  size_t runs = 0;
+
+  decimator_default_spec(&spec, 2, 5);
+  decimator_design(&dec, &spec);
+  decimator_reset(&state);
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch){
+    in[ch] = eeg[ch];
+    out[ch] = y[ch];
+  }
+
+  start = now_sec();
+  do{
+    decimator_process(&dec, &state, in, BENCH_SAMPLES, out);
+    ++runs;
+    elapsed = now_sec() - start;
+  }while(elapsed < BENCH_SECONDS);
+  report("decimator (250 -> 100 Hz, 80 dB)", (double)runs*BENCH_SAMPLES*EEG_CHANNELS, elapsed);
+}
+
+static void bench_eeg_quality(void){
+  static s_eegQualityPlan plan;
+  static s_eegQualityState state;
+  static s_eegQuality out[BENCH_SAMPLES/SAMPLE_RATE + 1];
+  static int16_t raw[EEG_CHANNELS][BENCH_SAMPLES];
+  s_eegQualitySpec spec;
+  const int16_t *channel[EEG_CHANNELS];
+  double start, elapsed;
+  size_t runs = 0;
+
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch){
+    for(size_t n=0; n<BENCH_SAMPLES; ++n)
+      raw[ch][n] = (int16_t)(100.0f*eeg[ch][n]);
+    channel[ch] = raw[ch];
+  }
+  eeg_quality_default_spec(&spec, SAMPLE_RATE);
+  eeg_quality_plan(&plan, &spec);
+  eeg_quality_reset(&state);
+
+  start = now_sec();
+  do{
+    eeg_quality_process(&plan, &state, channel, BENCH_SAMPLES, out);
+    ++runs;
+    elapsed = now_sec() - start;
+  }while(elapsed < BENCH_SECONDS);
+  report("eeg_quality (1 s epochs)", (double)runs*BENCH_SAMPLES*EEG_CHANNELS, elapsed);
+}
+
+static void bench_actigraphy(void){
+  static s_actigraphyEpoch out[BENCH_SAMPLES/(SAMPLE_RATE*30) + 1];
+  s_actigraphyConfig config;
+  s_actigraphyState state;
+  double start, elapsed;
+  size_t runs = 0;
+
+  actigraphy_default_config(&config, SAMPLE_RATE);
+  actigraphy_init(&state, &config);
+
+  start = now_sec();
+  do{
+    actigraphy_process(&state, acc[0], acc[1], acc[2], BENCH_SAMPLES, out);
+    ++runs;
+    elapsed = now_sec() - start;
+  }while(elapsed < BENCH_SECONDS);
+  report("actigraphy (30 s epochs)", (double)runs*BENCH_SAMPLES*3, elapsed);
+}
+
+/* Replays the test minute as a whole night, as it would be replayed from recording. */
+static void bench_sleep_events(void){
+  static s_sleepEventPlan plan;
+  static s_sleepEventState state;
+  static s_sleepEvent events[256];
+  s_sleepEventSpec spec;
+  const float *channel[EEG_CHANNELS];
+  const size_t minutes = 8*60;
+  double start, elapsed;
+
+  sleep_events_default_spec(&spec, SAMPLE_RATE);
+  sleep_events_plan(&plan, &spec);
+  sleep_events_reset(&state);
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+    channel[ch] = eeg[ch];
+
+  start = now_sec();
+  for(size_t m=0; m<minutes; ++m)
+    sleep_events_process(&plan, &state, channel, BENCH_SAMPLES, events, 256);
+  elapsed = now_sec() - start;
+  report("sleep_events (8 h night replay)", (double)minutes*BENCH_SAMPLES*EEG_CHANNELS, elapsed);
+  printf("%-36s %10.0f x real time\n", "", minutes*60.0/elapsed);
+}
+
+/* One IR/red sample pair counts as two samples; masks per core is pair rate over 100 Hz stream
+ * of one mask. */
+static void bench_spo2(void){
+  s_spo2Config config;
+  s_spo2State state;
+  s_spo2Result result;
+  double start, elapsed;
+  size_t runs = 0;
+
+  spo2_default_config(&config, PPG_RATE);
+  spo2_init(&state, &config);
+
+  start = now_sec();
+  do{
+    spo2_process(&state, ppg_ir, ppg_red, PPG_SAMPLES, &result);
+    ++runs;
+    elapsed = now_sec() - start;
+  }while(elapsed < BENCH_SECONDS);
+  report("spo2 (IR + red, 100 Hz)", (double)runs*PPG_SAMPLES*2, elapsed);
+  printf("%-36s %10.0f masks per core\n", "", (double)runs*PPG_SAMPLES/elapsed/PPG_RATE);
+}
+
+int main(void){
+  eeg_fill();
+  acc_fill();
+  ppg_fill();
+  bench_eeg_filter();
+  bench_band_power();
+  bench_decimator();
+  bench_eeg_quality();
+  bench_actigraphy();
+  bench_sleep_events();
+  bench_spo2();
+  return 0;
+}
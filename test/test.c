@@ -7,11 +7,37 @@
  * Description
  */
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "ic_actigraphy.h"
+#include "ic_alarm_scheduler.h"
+#include "ic_async.h"
+#include "ic_band_power.h"
+#include "ic_clock_sync.h"
+#include "ic_decimator.h"
 #include "ic_dfu.h"
+#include "ic_eeg_filter.h"
+#include "ic_eeg_quality.h"
 #include "ic_frame_handle.h"
+#include "ic_lod_pyramid.h"
 #include "ic_low_level_control.h"
+#include "ic_mask_emulator.h"
+#include "ic_pox_shadow.h"
+#include "ic_ppg_artifact.h"
+#include "ic_restore.h"
+#include "ic_ring_cache.h"
+#include "ic_sketch.h"
+#include "ic_sleep_events.h"
+#include "ic_sleep_stage.h"
+#include "ic_spo2.h"
+#include "ic_status_store.h"
+#include "ic_stimulation.h"
+#include "ic_stream_decoder.h"
+#include "ic_stream_merge.h"
+#include "ic_stream_tracker.h"
+#include "ic_timer_wheel.h"
 #include "ic_version.h"
 
 #define ARRAY_SIZE 20
@@ -21,6 +47,1450 @@
   printf("\n\r");\
 }while(0);
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define DECODER_FRAMES 37
+#define WHEEL_TIMERS   500
+#define RESTORE_REGS   40
+#define TRACKER_FRAMES 200
+#define MERGE_SECONDS  10
+#define FILTER_SAMPLES 2500
+#define POWER_SAMPLES  10500
+#define POWER_WINDOW   500
+#define POWER_HOP      250
+#define SPO2_SAMPLES   3000
+#define QUALITY_SAMPLES 2500
+#define STIM_SAMPLES   (60*250)
+#define STIM_MAX_SENT  32
+#define RING_ROWS      16
+#define LOD_BASE       16
+#define LOD_SAMPLES    10000
+#define LOD_PIXELS     100
+#define DECIM_SAMPLES  1000
+#define EVENT_RATE     250
+#define EVENT_SAMPLES  (240*EVENT_RATE)
+#define EVENT_MAX      64
+#define PPG_RATE       100
+#define PPG_STILL      20     // [s] before head starts to move
+#define PPG_SAMPLES    (120*PPG_RATE)
+#define SKETCH_VALUES  20000
+#define SKETCH_PARTS   7
+#define ACTI_EPOCHS    10
+#define ACTI_SAMPLES   (ACTI_EPOCHS*750)   // 30 s epochs at 25 Hz
+
+#define RUN_CHECK(check, name)do{\
+  if(!check()){\
+    printf(name ": FAILED\n");\
+    return -1;}\
+  printf(name ": OK\n");\
+}while(0)
+
+/* Batch decoder must give exactly what is read through packed frame structure. */
+static bool stream_decoder_check(void){
+  static u_otherDataFrameContainer other[DECODER_FRAMES];
+  static u_eegDataFrameContainter eeg[DECODER_FRAMES];
+  static uint32_t ts[DECODER_FRAMES];
+  static int32_t ir[DECODER_FRAMES], red[DECODER_FRAMES];
+  static int16_t acc[3][DECODER_FRAMES], eeg_ch[EEG_CHANNELS][DECODER_FRAMES];
+  static int8_t temp[2][DECODER_FRAMES];
+  s_otherColumns other_out = {ts, ir, red, acc[0], acc[1], acc[2], {temp[0], temp[1]}};
+  s_eegColumns eeg_out = {NULL, {0}};
+
+  srand(1);
+  for(size_t n=0; n<DECODER_FRAMES; ++n)
+    for(size_t i=0; i<ARRAY_SIZE; ++i){
+      other[n].raw_data[i] = rand();
+      eeg[n].raw_data[i] = rand();
+    }
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+    eeg_out.channel[ch] = eeg_ch[ch];
+
+  stream_decode_other(other, DECODER_FRAMES, &other_out);
+  stream_decode_eeg(eeg, DECODER_FRAMES, &eeg_out);
+
+  for(size_t n=0; n<DECODER_FRAMES; ++n){
+    if(ts[n] != other[n].frame.time_stamp || ir[n] != other[n].frame.ir_sample ||
+        red[n] != other[n].frame.red_sample || acc[0][n] != other[n].frame.acc[0] ||
+        acc[1][n] != other[n].frame.acc[1] || acc[2][n] != other[n].frame.acc[2] ||
+        temp[0][n] != other[n].frame.temp[0] || temp[1][n] != other[n].frame.temp[1])
+      return false;
+    for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+      if(eeg_ch[ch][n] != eeg[n].frame.eeg_data[ch])
+        return false;
+  }
+  return true;
+}
+
+/* Microvolt columns are raw samples scaled per channel, block and tail frames alike. */
+static bool eeg_uv_check(void){
+  static u_eegDataFrameContainter eeg[DECODER_FRAMES];
+  static uint32_t ts[DECODER_FRAMES];
+  static float uv[EEG_CHANNELS][DECODER_FRAMES];
+  s_eegColumnsUv out = {ts, {0}};
+  s_eegScale scale;
+
+  srand(2);
+  for(size_t n=0; n<DECODER_FRAMES; ++n)
+    for(size_t i=0; i<ARRAY_SIZE; ++i)
+      eeg[n].raw_data[i] = rand();
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch){
+    out.channel[ch] = uv[ch];
+    scale.gain[ch] = 0.0625f*(ch+1);
+    scale.offset[ch] = -10.0f*ch;
+  }
+
+  stream_decode_eeg_uv(eeg, DECODER_FRAMES, &scale, &out);
+
+  for(size_t n=0; n<DECODER_FRAMES; ++n){
+    if(ts[n] != eeg[n].frame.time_stamp) return false;
+    for(size_t ch=0; ch<EEG_CHANNELS; ++ch){
+      float expected = eeg[n].frame.eeg_data[ch]*scale.gain[ch] + scale.offset[ch];
+      if(fabsf(uv[ch][n] - expected) > 1e-3f) return false;
+    }
+  }
+  return true;
+}
+
+typedef struct{
+  s_twNode node;
+  uint64_t fired;   /*!< tick of expiry, 0 - not fired */
+}s_wheelTimer;
+
+static uint64_t wheel_now;
+
+static void wheel_expire(s_twNode *node, void *user){
+  s_wheelTimer *timer = TIMER_WHEEL_CONTAINER(node, s_wheelTimer, node);
+  if(timer->fired) ++*(size_t *)user;   // fired twice
+  timer->fired = wheel_now;
+}
+
+/* Every timer of every level (and overflow) fires once, not before it expires and not later than
+ * the advance which passes its tick; deleted timers never fire. */
+static bool timer_wheel_check(void){
+  static s_timerWheel tw;
+  static s_wheelTimer timer[WHEEL_TIMERS];
+  size_t errors = 0, fired = 0;
+
+  srand(2);
+  timer_wheel_init(&tw, 1000);
+  for(size_t i=0; i<WHEEL_TIMERS; ++i){
+    uint64_t delay = (uint64_t)rand() >> (rand()%24);
+
+    timer_wheel_node_init(&timer[i].node);
+    timer[i].fired = 0;
+    timer_wheel_add(&tw, &timer[i].node, 1000 + delay%(1u << 24) + (i%50 == 0 ? 1u << 25 : 0));
+  }
+  for(size_t i=0; i<WHEEL_TIMERS; i+=7)
+    if(!timer_wheel_del(&tw, &timer[i].node)) return false;
+
+  for(wheel_now=1000; wheel_now<(1u << 26); wheel_now+=1 + rand()%4096)
+    fired += timer_wheel_advance(&tw, wheel_now, wheel_expire, &errors);
+  fired += timer_wheel_advance(&tw, wheel_now, wheel_expire, &errors);
+
+  for(size_t i=0; i<WHEEL_TIMERS; ++i){
+    if(i%7 == 0){
+      if(timer[i].fired) return false;
+      continue;
+    }
+    if(!timer[i].fired || timer[i].fired < timer[i].node.expires ||
+        timer[i].fired >= timer[i].node.expires + 4096)
+      return false;
+  }
+  return errors == 0 && fired == WHEEL_TIMERS - (WHEEL_TIMERS + 6)/7 && tw.pending == 0;
+}
+
+static size_t alarm_frames;
+
+static void alarm_frame(s_alarmTimer *timer, char *frame, size_t len, int uuid, void *user){
+  (void)timer; (void)frame; (void)len; (void)uuid; (void)user;
+  ++alarm_frames;
+}
+
+/* Alarm is set when due, escalates SOFT -> MEDIUM -> HARD and cancel sends alarm_off. */
+static bool alarm_scheduler_check(void){
+  static s_alarmScheduler sched;
+  s_alarmTimer timer;
+
+  alarm_scheduler_init(&sched, 0, alarm_frame, NULL, 1);
+  alarm_timer_init(&timer, NULL);
+  if(!alarm_scheduler_arm(&sched, &timer, 10, ALARM_SOFT, 60, 30, 5)) return false;
+  if(alarm_scheduler_advance(&sched, 9) != 0 || alarm_frames != 0) return false;
+  if(alarm_scheduler_advance(&sched, 10) != 1 || !timer.set_on_device) return false;
+  if(alarm_scheduler_advance(&sched, 100) != 2 || alarm_frames != 3) return false;
+  if(timer.type != ALARM_HARD || alarm_timer_pending(&timer)) return false;
+  if(!alarm_scheduler_cancel(&sched, &timer) || alarm_frames != 4 || timer.set_on_device)
+    return false;
+  return !alarm_scheduler_cancel(&sched, &timer) && sched.frame_id == 5;
+}
+
+/* Builds pulse-oximeter response to command frame. */
+static void pox_ack(const char *cmd, bool state_code, char *rsp){
+  u_BLECmdPayload payload;
+  size_t len = NUC_FRAME_SIZE;
+
+  memset(&payload, 0, sizeof(payload));
+  memcpy(&payload.pox_rsp, &((const u_cmdFrameContainer *)cmd)->frame.payload.pox_cmd,
+      sizeof(s_poxCmd));
+  payload.pox_rsp.state_code = state_code;
+  resp_frame_copy_func(rsp, &len, (char *)&payload, PULSEOXIMETER_CMD);
+}
+
+/* Acks of writes sent before standard values were restored are not matched any more; the same
+ * value written twice stays in flight until the newer write is acknowledged. */
+static bool pox_shadow_check(void){
+  static const s_afe4400RegisterValue profile[] = {{0x01, 0x10}, {0x02, 0x20}, {0x03, 0x30}};
+  static s_poxShadow shadow;
+  char frames[3][NUC_FRAME_SIZE], cmd[NUC_FRAME_SIZE], rsp[NUC_FRAME_SIZE];
+  t_afe4400RegisterConf reg_val;
+  size_t len = sizeof(cmd);
+  uint16_t id = 10;
+
+  pox_shadow_init(&shadow);
+  if(pox_shadow_program(&shadow, profile, 3, frames, 3, &id) != 3) return false;
+  pox_ack(frames[0], true, rsp);
+  if(!pox_shadow_response_sink(&shadow, rsp) || !pox_shadow_get(&shadow, 0x01, &reg_val) ||
+      reg_val != 0x10)
+    return false;
+
+  pox_std_val_init(cmd, &len, id++);
+  pox_ack(cmd, true, rsp);
+  if(!pox_shadow_response_sink(&shadow, rsp) || pox_shadow_pending(&shadow) != 0) return false;
+  pox_ack(frames[1], true, rsp);
+  if(pox_shadow_response_sink(&shadow, rsp) || pox_shadow_get(&shadow, 0x02, &reg_val))
+    return false;
+  if(pox_shadow_program(&shadow, profile, 3, frames, 3, &id) != 3) return false;
+
+  pox_shadow_init(&shadow);
+  len = sizeof(cmd);
+  pox_shadow_write_register(&shadow, cmd, &len, 0x05, 0x55, 100);
+  len = sizeof(frames[0]);
+  pox_shadow_write_register(&shadow, frames[0], &len, 0x05, 0x55, 101);
+  pox_ack(cmd, true, rsp);
+  if(!pox_shadow_response_sink(&shadow, rsp) || !(shadow.in_flight & (1ull<<0x05))) return false;
+  pox_ack(frames[0], true, rsp);
+  return pox_shadow_response_sink(&shadow, rsp) && !(shadow.in_flight & (1ull<<0x05)) &&
+      pox_shadow_get(&shadow, 0x05, &reg_val) && reg_val == 0x55;
+}
+
+static uint16_t status_changed;
+static size_t status_notifications;
+
+static void status_change(const s_statusSnapshot *prev, const s_statusSnapshot *curr,
+    uint16_t changed, void *user){
+  (void)prev; (void)curr; (void)user;
+  status_changed = changed;
+  ++status_notifications;
+}
+
+/* Change mask has bits of changed devices and data streams only, id change alone is silent;
+ * status response frame is published as decoded. */
+static bool status_store_check(void){
+  static s_statusStore store;
+  s_statusSnapshot snap;
+  s_devsFunc func;
+  char rsp[NUC_FRAME_SIZE];
+  size_t len = sizeof(rsp);
+  uint32_t version;
+
+  status_store_init(&store, status_change, NULL);
+  memset(&func, FUN_TYPE_OFF, sizeof(func));
+  version = status_store_version(&store);
+  if(status_store_publish(&store, func, 0, 1) != 0 || status_notifications != 0) return false;
+
+  func.func_of_vibrator = FUN_TYPE_SIN_WAVE;
+  if(status_store_publish(&store, func, 0x03, 2) != (DEV_VIBRATOR|STATUS_CHANGE_DATA_STREAMS) ||
+      status_notifications != 1 || status_changed != (DEV_VIBRATOR|STATUS_CHANGE_DATA_STREAMS))
+    return false;
+  if(status_store_snapshot(&store, &snap) <= version || snap.id != 2 ||
+      snap.devs_func.func_of_vibrator != FUN_TYPE_SIN_WAVE || snap.active_data_streams != 0x03)
+    return false;
+
+  func.func_of_vibrator = FUN_TYPE_OFF;
+  status_rsp_gen_func(rsp, &len, func, 0x03, 3);
+  if(!status_store_publish_frame(&store, rsp) || status_changed != DEV_VIBRATOR) return false;
+  status_store_snapshot(&store, &snap);
+  return snap.id == 3 && snap.devs_func.func_of_vibrator == FUN_TYPE_OFF &&
+      status_store_version(&store) > version;
+}
+
+/* Sends frames to emulated mask, the first acks responses are passed to cache. */
+static bool restore_deliver(s_restoreCache *cache, s_maskEmulator *emu,
+    char (*frames)[NUC_FRAME_SIZE], size_t count, size_t acks){
+  for(size_t i=0; i<count; ++i){
+    char rsp[NUC_FRAME_SIZE];
+    int uuid;
+
+    if(!mask_emu_receive(emu, frames[i], NUC_FRAME_SIZE, 0)) return false;
+    if(mask_emu_poll(emu, 0, &uuid, rsp, sizeof(rsp)) != NUC_FRAME_SIZE) return false;
+    if(i < acks && !restore_cache_response(cache, rsp, 1000)) return false;
+  }
+  return true;
+}
+
+/* Mask state survives two reconnections, the second one in the middle of restoration, and every
+ * response of a full restoration burst is matched. */
+static bool restore_check(void){
+  static s_restoreCache cache;
+  static s_maskEmulator emu[3];
+  static char frames[RESTORE_MAX_FRAMES][NUC_FRAME_SIZE];
+  s_maskEmuConfig config = {0, 0, 0, 1, NULL};
+  uint8_t intensity[7] = {0, 0, 0, 0, 0, 0, 40};
+  size_t len, count = 0;
+  uint16_t id = 1;
+
+  restore_cache_init(&cache);
+  for(int i=0; i<3; ++i) mask_emu_init(&emu[i], &config);
+
+  len = NUC_FRAME_SIZE;
+  pox_hdw_init(frames[count++], &len, id++);
+  len = NUC_FRAME_SIZE;
+  pox_std_val_init(frames[count++], &len, id++);
+  for(t_afe4400Register reg=1; reg<=RESTORE_REGS; ++reg){
+    len = NUC_FRAME_SIZE;
+    pox_write_register(frames[count++], &len, reg, 0x1000 + reg, id++);
+  }
+  len = NUC_FRAME_SIZE;
+  device_set_func(frames[count++], &len, DEV_VIBRATOR, FUN_TYPE_ON, intensity, DEV_INF_DURATION, 0,
+      id++);
+  len = NUC_FRAME_SIZE;
+  alarm_set(frames[count++], &len, ALARM_SOFT, 3600, 30, id++);
+  for(size_t i=0; i<count; ++i)
+    if(!restore_cache_sent(&cache, frames[i])) return false;
+  if(!restore_deliver(&cache, &emu[0], frames, count, count)) return false;
+
+  count = restore_cache_build(&cache, NULL, 1000, frames, RESTORE_MAX_FRAMES, &id);
+  if(count != RESTORE_REGS + 4) return false;
+  if(!restore_deliver(&cache, &emu[1], frames, count, 2)) return false;
+
+  count = restore_cache_build(&cache, NULL, 1000, frames, RESTORE_MAX_FRAMES, &id);
+  if(count != RESTORE_REGS + 4 || !restore_deliver(&cache, &emu[2], frames, count, count))
+    return false;
+  if(memcmp(emu[0].pox_reg, emu[2].pox_reg, sizeof(emu[0].pox_reg)) || !emu[2].pox_initialized)
+    return false;
+  return emu[2].devs_func.func_of_vibrator == FUN_TYPE_ON && emu[2].alarm_type == ALARM_SOFT;
+}
+
+static s_asyncLoop async_loop;
+static s_asyncLoopback async_lb[3];
+static e_asyncResult async_result[3];
+static size_t async_done_cnt;
+
+/* Completion of request 0 detaches its own transport and the next one. */
+static void async_done(s_asyncRequest *req, e_asyncResult result, char *rsp_frame, void *user){
+  size_t i = (size_t)(uintptr_t)user;
+
+  (void)req; (void)rsp_frame;
+  async_result[i] = result;
+  ++async_done_cnt;
+  if(i == 0){
+    async_loop_detach(&async_loop, &async_lb[0].transport);
+    async_loop_detach(&async_loop, &async_lb[1].transport);
+  }
+}
+
+/* Requests complete once with response, detach or timeout; transports may be detached from
+ * inside handlers while the loop polls them. */
+static bool async_check(void){
+  static s_asyncRequest req[3], dup;
+  char frame[NUC_FRAME_SIZE];
+  size_t len;
+
+  async_loop_init(&async_loop, 0);
+  for(size_t i=0; i<3; ++i){
+    async_loopback_init(&async_lb[i]);
+    async_loop_attach(&async_loop, &async_lb[i].transport);
+    async_result[i] = ASYNC_OK;
+  }
+  async_lb[2].mute = true;
+
+  for(size_t i=0; i<3; ++i){
+    len = sizeof(frame);
+    vibrator_ON(frame, &len, (uint16_t)(i + 1));
+    if(!async_send(&async_loop, &req[i], &async_lb[i].transport, frame, CMD_UUID, 100,
+          async_done, (void *)(uintptr_t)i))
+      return false;
+  }
+  /* the same command and id may not be in flight twice on one transport, and request whose send
+   * failed is not in flight even if its storage held garbage */
+  memset(&dup, 0xA5, sizeof(dup));
+  if(async_send(&async_loop, &dup, &async_lb[2].transport, frame, CMD_UUID, 100, async_done,
+        NULL) || async_cancel(&async_loop, &dup) || async_loop_pending(&async_loop) != 3)
+    return false;
+  memset(&dup, 0xA5, sizeof(dup));
+  if(async_send(&async_loop, &dup, &async_lb[2].transport, frame, CMD_UUID, 100, NULL, NULL) ||
+      async_cancel(&async_loop, &dup))
+    return false;
+
+  async_loop_run_once(&async_loop, 50);
+  if(async_done_cnt != 2 || async_result[0] != ASYNC_OK || async_result[1] != ASYNC_DETACHED ||
+      async_loop_pending(&async_loop) != 1)
+    return false;
+  async_loop_run_once(&async_loop, 99);
+  if(async_done_cnt != 2) return false;
+  async_loop_run_once(&async_loop, 100);
+  return async_done_cnt == 3 && async_result[2] == ASYNC_TIMEOUT &&
+      async_loop_pending(&async_loop) == 0;
+}
+
+/* Device response keeps duration and period in their own fields. */
+static bool dev_response_check(void){
+  char rsp[NUC_FRAME_SIZE];
+  size_t len = sizeof(rsp);
+  const s_deviceRsp *payload = &((const u_cmdFrameContainer *)rsp)->frame.payload.device_rsp;
+
+  if(dev_resp_frame_gen_func(rsp, &len, DEV_VIBRATOR, FUN_TYPE_SIN_WAVE, 70000, 500, true, 7) !=
+      RESPONSE_UUID)
+    return false;
+  return payload->duration == 70000 && payload->period == 500 && payload->id == 7 &&
+      payload->func_type == FUN_TYPE_SIN_WAVE && payload->state_code;
+}
+
+/* Status is notified on status characteristic, command responses on response characteristic, both
+ * after configured latency; the emulator works as async loop transport. */
+static bool mask_emulator_check(void){
+  static s_maskEmulator emu;
+  static s_asyncRequest req;
+  s_maskEmuConfig config = {5, 0, 0, 1, &async_loop.now};
+  char frame[NUC_FRAME_SIZE], rsp[NUC_FRAME_SIZE];
+  size_t len = sizeof(frame);
+  int uuid;
+
+  mask_emu_init(&emu, &config);
+  status_cmd_gen_func(frame, &len, 1);
+  mask_emu_receive(&emu, frame, len, 0);
+  len = sizeof(frame);
+  vibrator_ON(frame, &len, 2);
+  mask_emu_receive(&emu, frame, len, 0);
+  if(mask_emu_poll(&emu, 4, &uuid, rsp, sizeof(rsp)) != 0) return false;
+  if(mask_emu_poll(&emu, 5, &uuid, rsp, sizeof(rsp)) != NUC_FRAME_SIZE ||
+      uuid != STATUS_STREAM_UUID)
+    return false;
+  if(mask_emu_poll(&emu, 5, &uuid, rsp, sizeof(rsp)) != NUC_FRAME_SIZE || uuid != RESPONSE_UUID ||
+      !frame_resp_cmp(frame, rsp) || emu.devs_func.func_of_vibrator != FUN_TYPE_ON)
+    return false;
+
+  async_loop_init(&async_loop, 0);
+  async_loop_attach(&async_loop, &emu.transport);
+  len = sizeof(frame);
+  status_cmd_gen_func(frame, &len, 3);
+  async_result[2] = ASYNC_DETACHED;
+  if(!async_send(&async_loop, &req, &emu.transport, frame, CMD_UUID, 100, async_done,
+        (void *)(uintptr_t)2))
+    return false;
+  async_loop_run_once(&async_loop, 4);
+  if(async_loop_pending(&async_loop) != 1) return false;
+  async_loop_run_once(&async_loop, 5);
+  return async_loop_pending(&async_loop) == 0 && async_result[2] == ASYNC_OK;
+}
+
+/* Forward jump of time stamps by more than half of the range resynchronizes the tracker after a
+ * run of late frames, also across batches; lost samples of long gaps do not overflow. */
+static bool stream_tracker_check(void){
+  static uint32_t ts[TRACKER_FRAMES], index[TRACKER_FRAMES];
+  static uint64_t unwrapped[TRACKER_FRAMES];
+  s_streamTracker tracker;
+  s_streamGap gap;
+  size_t accepted = 0, no_gaps;
+
+  for(size_t n=0; n<TRACKER_FRAMES; ++n)
+    ts[n] = 0xFFFFFF00u + 10*n + (n >= TRACKER_FRAMES/2 ? 0x90000000u : 0);
+
+  stream_tracker_init(&tracker, 10, 2, 4);
+  for(size_t n=0; n<TRACKER_FRAMES; n+=7){
+    size_t count = n+7 < TRACKER_FRAMES ? 7 : TRACKER_FRAMES-n;
+    size_t batch = stream_tracker_process(&tracker, &ts[n], count, index, &unwrapped[accepted],
+        NULL, 0, NULL);
+    for(size_t i=0; i<batch; ++i)
+      if(ts[n+index[i]] != (uint32_t)unwrapped[accepted+i]) return false;
+    accepted += batch;
+  }
+  if(accepted != TRACKER_FRAMES - (STREAM_TRACKER_RESYNC-1) || tracker.stats.resyncs != 1 ||
+      tracker.stats.late != STREAM_TRACKER_RESYNC-1 || tracker.stats.gaps != 0)
+    return false;
+  for(size_t i=1; i<accepted; ++i)
+    if(unwrapped[i] <= unwrapped[i-1]) return false;
+  if(unwrapped[accepted-1] - unwrapped[0] != 10*(TRACKER_FRAMES-1) + 0x90000000ull)
+    return false;
+
+  /* single late frame is dropped, tracker stays on its time base */
+  ts[0] = 1000;
+  ts[1] = 990;
+  ts[2] = 1010;
+  stream_tracker_init(&tracker, 10, 2, 4);
+  if(stream_tracker_process(&tracker, ts, 3, NULL, NULL, NULL, 0, NULL) != 2 ||
+      tracker.stats.late != 1 || tracker.late_run != 0)
+    return false;
+
+  ts[0] = 0;
+  ts[1] = 0x7FFFFFF0u;
+  stream_tracker_init(&tracker, 1, 0, 16);
+  stream_tracker_process(&tracker, ts, 2, NULL, NULL, &gap, 1, &no_gaps);
+  return no_gaps == 1 && gap.lost_frames == 0x7FFFFFEFu &&
+      gap.lost_samples == 0x7FFFFFEFull*16;
+}
+
+static uint32_t test_random(uint32_t *state){
+  uint32_t x = *state;
+  x ^= x<<13;
+  x ^= x>>17;
+  x ^= x<<5;
+  return *state = x;
+}
+
+/* Simulated 8 h night of 250 Hz frames from 1 kHz device clock 35 ppm slow, 7-27 ms BLE latency
+ * and one congested minute: after 10 min warm-up device time stamps map to host time (plus
+ * minimal latency) with error below 0.11 ms. */
+static bool clock_sync_check(void){
+  const int64_t host0 = 123456789;
+  s_clockSync cs;
+  uint32_t rng = 1;
+
+  clock_sync_init(&cs, 1000, 2000, 0.99, 500);
+  for(uint64_t ts=0; ts<8ull*3600*1000; ts+=4){
+    int64_t truth = host0 + (int64_t)(ts*1000*(1 + 35e-6) + 0.5);
+    int64_t latency = 7000 + test_random(&rng)%20001;
+
+    if(ts >= 4ull*3600*1000 && ts < 4ull*3600*1000 + 60000) latency += 200000;
+    clock_sync_add(&cs, ts, truth + latency);
+    if(ts >= 600000 && ts%1000 == 0){
+      int64_t error = clock_sync_to_host(&cs, ts) - (truth + 7000);
+      if(error > 110 || error < -110) return false;
+    }
+  }
+  return clock_sync_skew(&cs) > 34e-6 && clock_sync_skew(&cs) < 36e-6;
+}
+
+/* 250 Hz and 25 Hz linear ramps pushed in interleaved batches merge into consecutive 100 Hz records
+ * with exactly interpolated values; gap in slow input makes its values stale after stale_us. */
+static bool stream_merge_check(void){
+  static s_streamMerge merge;
+  static s_mergeRecord record[MERGE_SECONDS*100];
+  s_streamMergeConfig config = {10000, 100000, 50000, MERGE_LINEAR};
+  int64_t time[10];
+  float fast[2][10], slow[10];
+  const float *fast_col[2] = {fast[0], fast[1]}, *slow_col[1] = {slow};
+  size_t records = 0;
+  int in0, in1;
+
+  stream_merge_init(&merge, &config);
+  in0 = stream_merge_add_input(&merge, 2);
+  in1 = stream_merge_add_input(&merge, 1);
+  if(in0 != 0 || in1 != 1 || merge.channels != 3) return false;
+
+  for(int64_t chunk=0; chunk<MERGE_SECONDS*25; ++chunk){
+    /* 10 fast samples and 1 slow sample cover 40 ms; slow input is missing in 4-5 s */
+    for(int i=0; i<10; ++i){
+      time[i] = chunk*40000 + i*4000;
+      fast[0][i] = time[i]*1e-3f;
+      fast[1][i] = -2e-3f*time[i];
+    }
+    stream_merge_push(&merge, in0, time, fast_col, 10);
+    time[0] = chunk*40000;
+    slow[0] = 1000.0f - time[0]*1e-3f;
+    if(time[0] < 4000000 || time[0] >= 5000000)
+      stream_merge_push(&merge, in1, time, slow_col, 1);
+    records += stream_merge_pull(&merge, &record[records], MERGE_SECONDS*100 - records);
+  }
+  if(records < MERGE_SECONDS*100 - 20 || merge.late || merge.overruns) return false;
+
+  for(size_t n=0; n<records; ++n){
+    const s_mergeRecord *rec = &record[n];
+    float t_ms = rec->time_us*1e-3f;
+    bool gap = rec->time_us > 3960000 && rec->time_us < 5000000;
+    bool stale = rec->time_us > 3960000 + config.stale_us && rec->time_us < 5000000;
+
+    if(rec->time_us != (int64_t)n*10000) return false;
+    if((rec->stale & 0x01) || ((rec->stale & 0x02) != 0) != stale) return false;
+    if(fabsf(rec->value[0] - t_ms) > 0.01f || fabsf(rec->value[1] + 2*t_ms) > 0.02f)
+      return false;
+    if(!gap && fabsf(rec->value[2] - (1000.0f - t_ms)) > 0.01f) return false;
+  }
+  return true;
+}
+
+/* Invalid band is rejected; filtering in uneven batches matches double precision cascade of the
+ * designed sections, passes 10 Hz and removes 50 Hz mains. */
+static bool eeg_filter_check(void){
+  static float input[EEG_CHANNELS][FILTER_SAMPLES], signal[EEG_CHANNELS][FILTER_SAMPLES];
+  s_eegFilterSpec spec = {250, 50, 30, false, 0.5f, 35, 4};
+  s_eegFilterSpec bad = spec;
+  s_eegFilter filter;
+  s_eegFilterState state;
+  float *channel[EEG_CHANNELS];
+  double power[2] = {0};
+
+  bad.highpass = bad.lowpass;
+  if(eeg_filter_design(&filter, &bad) || !eeg_filter_design(&filter, &spec)) return false;
+
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+    for(size_t n=0; n<FILTER_SAMPLES; ++n)
+      signal[ch][n] = input[ch][n] = (float)(20*sin(2*M_PI*10*n/250 + ch) +
+          (ch%2 ? 100*sin(2*M_PI*50*n/250) : 0));
+
+  eeg_filter_reset(&state);
+  for(size_t n=0, batch=1; n<FILTER_SAMPLES; n+=batch, batch=batch%13 + 3){
+    if(n + batch > FILTER_SAMPLES) batch = FILTER_SAMPLES - n;
+    for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+      channel[ch] = &signal[ch][n];
+    eeg_filter_process(&filter, &state, channel, batch);
+  }
+
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch){
+    double z1[EEG_FILTER_MAX_SECTIONS] = {0}, z2[EEG_FILTER_MAX_SECTIONS] = {0};
+
+    for(size_t n=0; n<FILTER_SAMPLES; ++n){
+      double x = input[ch][n];
+
+      for(uint8_t k=0; k<filter.no_of_sections; ++k){
+        double y = filter.b0[k]*x + z1[k];
+        z1[k] = filter.b1[k]*x - filter.a1[k]*y + z2[k];
+        z2[k] = filter.b2[k]*x - filter.a2[k]*y;
+        x = y;
+      }
+      if(fabs(signal[ch][n] - x) > 0.01) return false;
+      if(n >= FILTER_SAMPLES/2) power[ch%2] += x*x;
+    }
+  }
+  /* 10 Hz sine of amplitude 20 has power 200, mains must not add more than 1% */
+  power[0] /= EEG_CHANNELS/2*(FILTER_SAMPLES/2);
+  power[1] /= EEG_CHANNELS/2*(FILTER_SAMPLES/2);
+  return power[0] > 180 && power[0] < 220 && fabs(power[1] - power[0]) < 2;
+}
+
+/* Band powers of sliding DFT, fed in uneven batches past exact resynchronization, match direct
+ * double precision DFT of Hann windowed signal. */
+static bool band_power_check(void){
+  static float signal[EEG_CHANNELS][POWER_SAMPLES];
+  static s_bandPowerPlan plan;
+  static s_bandPowerState state;
+  static s_bandPower out[POWER_SAMPLES/POWER_HOP];
+  const float *channel[EEG_CHANNELS];
+  s_bandPowerSpec spec;
+  size_t outputs = 0;
+  uint32_t rng = 3;
+
+  band_power_default_spec(&spec, 250, POWER_WINDOW, POWER_HOP);
+  if(!band_power_plan(&plan, &spec)) return false;
+  band_power_reset(&state);
+
+  for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+    for(size_t n=0; n<POWER_SAMPLES; ++n)
+      signal[ch][n] = (float)(30*sin(2*M_PI*(2 + ch)*n/250) + 20*sin(2*M_PI*(13 + ch)*n/250) +
+          (double)(test_random(&rng)%2001)/100 - 10);
+
+  for(size_t n=0, batch=5; n<POWER_SAMPLES; n+=batch, batch=batch*7%61 + 1){
+    if(n + batch > POWER_SAMPLES) batch = POWER_SAMPLES - n;
+    for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+      channel[ch] = &signal[ch][n];
+    outputs += band_power_process(&plan, &state, channel, batch, &out[outputs]);
+  }
+  if(outputs != (POWER_SAMPLES - POWER_WINDOW)/POWER_HOP + 1) return false;
+
+  for(size_t j=0; j<outputs; ++j){
+    size_t first = j*POWER_HOP;   // window is multiple of hop, first output ends at window
+
+    for(size_t ch=0; ch<EEG_CHANNELS; ++ch){
+      double power[EEG_BANDS] = {0}, total = 0;
+
+      for(int b=0; b<EEG_BANDS; ++b){
+        for(int k=(int)ceil(spec.edge[b]*POWER_WINDOW/250.0);
+            k<(int)ceil(spec.edge[b+1]*POWER_WINDOW/250.0); ++k){
+          double re = 0, im = 0;
+          for(size_t m=0; m<POWER_WINDOW; ++m){
+            double x = signal[ch][first+m]*(0.5 - 0.5*cos(2*M_PI*m/POWER_WINDOW));
+            re += x*cos(2*M_PI*k*m/POWER_WINDOW);
+            im -= x*sin(2*M_PI*k*m/POWER_WINDOW);
+          }
+          power[b] += (re*re + im*im)*16/(3.0*POWER_WINDOW*POWER_WINDOW);
+        }
+        total += power[b];
+      }
+      for(int b=0; b<EEG_BANDS; ++b)
+        if(fabs(out[j].power[b][ch] - power[b]) > 1e-3*power[b] + 1e-5*total) return false;
+    }
+  }
+  return true;
+}
+
+/* Synthetic 72 bpm pulse with ratio of ratios 0.6 gives heart rate 72 and SpO2 95% (default
+ * calibration) without quality flags; low DC is reported as no contact. */
+static bool spo2_check(void){
+  static int32_t ir[SPO2_SAMPLES], red[SPO2_SAMPLES];
+  s_spo2Config config;
+  s_spo2State state;
+  s_spo2Result result;
+
+  for(size_t n=0; n<SPO2_SAMPLES; ++n){
+    double phase = fmod(n*1.2/100, 1.0);
+    /* fast systolic rise, slow diastolic decay */
+    double pulse = phase < 0.15 ? sin(M_PI/2*phase/0.15) : exp(-(phase - 0.15)*4);
+
+    ir[n] = (int32_t)(100000 - 1000*pulse);
+    red[n] = (int32_t)(80000 - 480*pulse);
+  }
+
+  spo2_default_config(&config, 100);
+  spo2_init(&state, &config);
+  for(size_t n=0, batch=1; n<SPO2_SAMPLES; n+=batch, batch=batch%41 + 7){
+    if(n + batch > SPO2_SAMPLES) batch = SPO2_SAMPLES - n;
+    spo2_process(&state, &ir[n], &red[n], batch, &result);
+  }
+  if(result.quality || fabsf(result.heart_rate - 72) > 1 || fabsf(result.spo2 - 95) > 1)
+    return false;
+
+  for(size_t n=0; n<SPO2_SAMPLES; ++n){
+    ir[n] /= 20;
+    red[n] /= 20;
+  }
+  spo2_init(&state, &config);
+  spo2_process(&state, ir, red, SPO2_SAMPLES, &result);
+  return (result.quality & SPO2_QUALITY_NO_CONTACT) != 0;
+}
+
+/* Epochs computed in uneven batches (vector and tail path) match double precision reference of
+ * high-pass, magnitude, PIM, peak, time above threshold and crossings. */
+static bool actigraphy_check(void){
+  static int16_t acc[3][ACTI_SAMPLES];
+  static s_actigraphyEpoch out[ACTI_EPOCHS];
+  s_actigraphyConfig config;
+  s_actigraphyState state;
+  size_t epochs = 0;
+  uint32_t rng = 4;
+  double hp[3] = {0}, a;
+  int side[3] = {0};
+
+  actigraphy_default_config(&config, 25);
+  if(!actigraphy_init(&state, &config)) return false;
+  a = state.hp_alpha;
+
+  for(size_t n=0; n<ACTI_SAMPLES; ++n){
+    /* gravity on z, movement bursts in every other epoch */
+    bool moving = (n/750)%2 && n%750 < 200;
+    for(int axis=0; axis<3; ++axis)
+      acc[axis][n] = (int16_t)((axis == 2 ? 16384 : 0) + (int)(test_random(&rng)%41) - 20 +
+          (moving ? (int)(test_random(&rng)%4001) - 2000 : 0));
+  }
+
+  for(size_t n=0, batch=3; n<ACTI_SAMPLES; n+=batch, batch=batch*5%97 + 1){
+    if(n + batch > ACTI_SAMPLES) batch = ACTI_SAMPLES - n;
+    epochs += actigraphy_process(&state, &acc[0][n], &acc[1][n], &acc[2][n], batch,
+        &out[epochs]);
+  }
+  if(epochs != ACTI_EPOCHS) return false;
+
+  for(size_t e=0; e<ACTI_EPOCHS; ++e){
+    double pim = 0, peak = 0;
+    uint32_t above = 0, zc = 0;
+
+    for(size_t n=e*750; n<(e+1)*750; ++n){
+      double mag = 0;
+      for(int axis=0; axis<3; ++axis){
+        hp[axis] = a*(hp[axis] + (n ? acc[axis][n] - acc[axis][n-1] : 0));
+        mag += hp[axis]*hp[axis];
+        if(config.mg_per_lsb*fabs(hp[axis]) > config.threshold){
+          int now = hp[axis] > 0 ? 1 : -1;
+          zc += side[axis] == -now;
+          side[axis] = now;
+        }
+      }
+      mag = config.mg_per_lsb*sqrt(mag);
+      pim += mag/25;
+      peak = mag > peak ? mag : peak;
+      above += mag > config.threshold;
+    }
+    if(out[e].index != e || fabs(out[e].pim - pim) > 1e-3*pim + 1e-3 ||
+        fabs(out[e].peak - peak) > 1e-3*peak || fabs(out[e].tat*25 - above) > 1 ||
+        abs((int)out[e].zc - (int)zc) > 1)
+      return false;
+    if(((out[e].flags & ACTIGRAPHY_MOVEMENT) != 0) != (e%2 == 1)) return false;
+  }
+  return true;
+}
+
+/* Channels which are clipped, flat, too large or dominated by mains are flagged in every epoch,
+ * clean channels never, also when epochs are split across batches. */
+static bool eeg_quality_check(void){
+  static int16_t signal[EEG_CHANNELS][QUALITY_SAMPLES];
+  static s_eegQualityPlan plan;
+  s_eegQualityState state;
+  s_eegQualitySpec spec;
+  s_eegQuality out[QUALITY_SAMPLES/250 + 1];
+  const int16_t *channel[EEG_CHANNELS];
+  size_t epochs = 0;
+  uint32_t rng = 5;
+
+  eeg_quality_default_spec(&spec, 250);
+  if(!eeg_quality_plan(&plan, &spec)) return false;
+  eeg_quality_reset(&state);
+
+  for(size_t n=0; n<QUALITY_SAMPLES; ++n){
+    double eeg = 300*sin(2*M_PI*7*n/250) + (double)(test_random(&rng)%201) - 100;
+    double clipped = 40000*sin(2*M_PI*1.3*n/250);
+
+    for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+      signal[ch][n] = (int16_t)(eeg + 10*ch);
+    signal[1][n] = (int16_t)(clipped > 32767 ? 32767 : clipped < -32768 ? -32768 : clipped);
+    signal[2][n] = (int16_t)(-50 + test_random(&rng)%3);
+    signal[3][n] = (int16_t)(16000*sin(2*M_PI*3*n/250));
+    signal[4][n] = (int16_t)(eeg + 2000*sin(2*M_PI*50*n/250));
+  }
+
+  for(size_t n=0, batch=7; n<QUALITY_SAMPLES; n+=batch, batch=batch*3%101 + 1){
+    if(n + batch > QUALITY_SAMPLES) batch = QUALITY_SAMPLES - n;
+    for(size_t ch=0; ch<EEG_CHANNELS; ++ch)
+      channel[ch] = &signal[ch][n];
+    epochs += eeg_quality_process(&plan, &state, channel, batch, &out[epochs]);
+  }
+  if(epochs != QUALITY_SAMPLES/250) return false;
+
+  for(size_t e=0; e<epochs; ++e)
+    if(out[e].index != e || out[e].clipped != 0x02 || out[e].flat != 0x04 ||
+        out[e].excessive != 0x0A || out[e].line_noise != 0x10 || out[e].bad != 0x1E)
+      return false;
+  return true;
+}
+
+static const s_sleepTree sleep_trees[] = {
+  SLEEP_TREE(SLEEP_STAGE_N3, SLEEP_NODE(REL_DELTA, 0.5f, 1, 2), SLEEP_LEAF(-1.0f),
+      SLEEP_LEAF(1.5f)),
+  SLEEP_TREE(SLEEP_STAGE_WAKE, SLEEP_NODE(TAT, 5.0f, 1, 2), SLEEP_LEAF(-0.5f),
+      SLEEP_NODE(LOG_PIM, 2.0f, 3, 4), SLEEP_LEAF(0.5f), SLEEP_LEAF(1.5f)),
+  SLEEP_TREE(SLEEP_STAGE_N2, SLEEP_NODE(REL_SIGMA, 0.12f, 1, 2), SLEEP_LEAF(-0.5f),
+      SLEEP_LEAF(0.5f)),
+  SLEEP_TREE(SLEEP_STAGE_REM, SLEEP_LEAF(0.0f)),
+};
+static const s_sleepModel sleep_model = {sleep_trees, sizeof(sleep_trees)/sizeof(sleep_trees[0])};
+/* child pointing back to root would never reach a leaf */
+static const s_sleepTree sleep_loop_tree[] = {
+  SLEEP_TREE(SLEEP_STAGE_N1, SLEEP_NODE(TAT, 5.0f, 1, 0), SLEEP_LEAF(0.0f)),
+};
+static const s_sleepModel sleep_loop_model = {sleep_loop_tree, 1};
+
+/* Fixed feature vectors of caller model: delta dominated still epoch is N3 (scores N3 1.5,
+ * REM/N1 0, N2/wake -0.5), moving epoch with time above threshold is wake; channel bad in most
+ * quality epochs is excluded. Models with trees that may not end in a leaf are refused. */
+static bool sleep_stage_check(void){
+  static const float deep[EEG_BANDS] = {800, 100, 50, 30, 20};
+  static const float awake[EEG_BANDS] = {20, 10, 30, 10, 30};
+  s_sleepStager stager;
+  s_bandPower power;
+  s_eegQuality quality[2] = {{0}};
+  s_actigraphyEpoch activity = {0};
+  s_sleepEpoch epoch;
+
+  if(sleep_stage_init(&stager, NULL) || sleep_stage_init(&stager, &sleep_loop_model) ||
+      !sleep_stage_init(&stager, &sleep_model))
+    return false;
+  for(int b=0; b<EEG_BANDS; ++b)
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      power.power[b][ch] = deep[b];
+  quality[0].bad = quality[1].bad = 0x80;
+  sleep_stage_add_band_power(&stager, &power, 1);
+  sleep_stage_add_quality(&stager, quality, 2);
+  if(sleep_stage_epoch(&stager, &activity, &epoch) != SLEEP_STAGE_N3 || epoch.channels != 0x7F ||
+      fabsf(epoch.feature[SLEEP_FEATURE_LOG_POWER] - 3.0f) > 1e-4f ||
+      fabsf(epoch.feature[SLEEP_FEATURE_REL_DELTA] - 0.8f) > 1e-4f ||
+      fabs(epoch.confidence - 1/(1 + 2*exp(-1.5) + 2*exp(-2.0))) > 1e-4)
+    return false;
+
+  for(int b=0; b<EEG_BANDS; ++b)
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      power.power[b][ch] = awake[b];
+  activity.pim = 500;
+  activity.tat = 20;
+  sleep_stage_add_band_power(&stager, &power, 1);
+  if(sleep_stage_epoch(&stager, &activity, &epoch) != SLEEP_STAGE_WAKE || epoch.index != 1 ||
+      epoch.channels != 0xFF || epoch.feature[SLEEP_FEATURE_TAT] != 20)
+    return false;
+
+  /* all channels bad */
+  quality[0].bad = quality[1].bad = 0xFF;
+  sleep_stage_add_band_power(&stager, &power, 1);
+  sleep_stage_add_quality(&stager, quality, 2);
+  return sleep_stage_epoch(&stager, &activity, NULL) == SLEEP_STAGE_UNKNOWN;
+}
+
+typedef struct{
+  s_asyncTransport transport;   /*!< has to be first */
+  uint64_t now_us;              /*!< host clock */
+  uint16_t id[STIM_MAX_SENT];
+  uint64_t sent_us[STIM_MAX_SENT];
+  size_t sent;
+}s_stimProbe;
+
+static bool stim_probe_send(s_asyncTransport *transport, int uuid, const char *frame, size_t len){
+  s_stimProbe *probe = (s_stimProbe *)transport;
+  const u_cmdFrameContainer *cmd = (const u_cmdFrameContainer *)frame;
+
+  if(uuid != CMD_UUID || !neuroon_cmd_frame_validate((uint8_t *)frame, len) ||
+      probe->sent >= STIM_MAX_SENT)
+    return false;
+  probe->id[probe->sent] = cmd->frame.payload.device_cmd.id;
+  probe->sent_us[probe->sent++] = probe->now_us;
+  return true;
+}
+
+static uint64_t stim_probe_clock(void *user){
+  return ((s_stimProbe *)user)->now_us;
+}
+
+/* Noisy 0.8 Hz slow oscillation delivered in batches of 1-12 samples: every stimulus lands (send
+ * plus lead) near the up-state peak, frames carry ids of the reserved range in turn. */
+static bool stimulation_check(void){
+  static float eeg[STIM_SAMPLES];
+  static s_stimulator stim;
+  static s_stimProbe probe;
+  s_stimConfig config;
+  uint32_t rng = 6;
+
+  for(size_t n=0; n<STIM_SAMPLES; ++n)
+    eeg[n] = (float)(60*sin(2*M_PI*0.8*n/250) + (double)(test_random(&rng)%21) - 10);
+
+  stim_default_config(&config, 250);
+  probe.transport.send = stim_probe_send;
+  if(!stim_init(&stim, &config, &probe.transport, stim_probe_clock, &probe) ||
+      stim_prepare_vibration(&stim, FUN_TYPE_ON, 50, 100, 0, 1000, 0) ||
+      !stim_prepare_vibration(&stim, FUN_TYPE_ON, 50, 100, 0, 1000, 3))
+    return false;
+
+  for(size_t n=0, batch=4; n<STIM_SAMPLES; n+=batch, batch=batch*7%12 + 1){
+    if(n + batch > STIM_SAMPLES) batch = STIM_SAMPLES - n;
+    /* newest sample of batch arrives 20 ms after it was taken, decision takes 100 us */
+    uint64_t rx_us = (uint64_t)(n + batch - 1)*4000 + 20000;
+    probe.now_us = rx_us + 100;
+    stim_process(&stim, &eeg[n], batch, rx_us);
+  }
+  /* one stimulus every second or third cycle (2.5 s refractory) */
+  if(probe.sent < 15 || stim.stats.fired != probe.sent) return false;
+
+  for(size_t i=0; i<probe.sent; ++i){
+    /* signal time at which stimulus takes effect */
+    double t = (probe.sent_us[i] + config.lead_us - 20000)*1e-6;
+    double phase = fmod(2*M_PI*0.8*t, 2*M_PI);
+
+    if(fabs(phase - M_PI/2) > 0.35 || probe.id[i] != 1000 + i%3) return false;
+  }
+  return stim.stats.max_latency_us == 100;
+}
+
+/* Queries find time ranges across wrap; slice is invalid once writer overwrites rows its query
+ * searched, even below the slice. */
+static bool ring_cache_check(void){
+  static uint64_t time[RING_ROWS];
+  static int16_t column[RING_ROWS];
+  const uint8_t size[1] = {sizeof(int16_t)};
+  void *columns[1] = {column};
+  uint64_t t[RING_ROWS+9];
+  int16_t v[RING_ROWS+9];
+  s_ringCache cache;
+  s_ringSlice slice;
+
+  if(!ring_cache_init(&cache, RING_ROWS, time, 1, size, columns)) return false;
+  for(size_t n=0; n<RING_ROWS+9; ++n){
+    t[n] = 10*n;
+    v[n] = (int16_t)n;
+  }
+
+  /* rows 0-15 at times 0-150, search for 100 reads rows 8, 12, 10, 9 */
+  ring_cache_append(&cache, t, (const void *[]){v}, RING_ROWS);
+  if(ring_cache_query(&cache, 100, 120, &slice) != 2 || slice.first != 10 ||
+      slice.time[0][0] != 100 || ((const int16_t *)slice.column[0][0])[1] != 11)
+    return false;
+  ring_cache_append(&cache, &t[RING_ROWS], (const void *[]){&v[RING_ROWS]}, 8);
+  if(!ring_cache_valid(&cache, &slice)) return false;
+  /* row 8 is not in slice, but search read it */
+  ring_cache_append(&cache, &t[RING_ROWS+8], (const void *[]){&v[RING_ROWS+8]}, 1);
+  if(ring_cache_valid(&cache, &slice)) return false;
+
+  /* rows 9-24 now, range wraps the ring */
+  if(ring_cache_query(&cache, 125, 1000, &slice) != 12 || slice.len[0] != 3 ||
+      slice.len[1] != 9 || slice.time[1][8] != 240 ||
+      ((const int16_t *)slice.column[0][1])[8] != 24 || !ring_cache_valid(&cache, &slice))
+    return false;
+  return ring_cache_last(&cache, 100, &slice) == RING_ROWS && slice.first == 9;
+}
+
+/* Appends samples from..to of channels to pyramid in batches of up to 37 samples. */
+static bool lod_append_range(s_lodPyramid *lod, int16_t channel[EEG_CHANNELS][LOD_SAMPLES],
+    size_t from, size_t to){
+  while(from < to){
+    size_t n = to - from < 37 ? to - from : 37;
+    const int16_t *batch[EEG_CHANNELS];
+
+    for(int ch=0; ch<EEG_CHANNELS; ++ch) batch[ch] = &channel[ch][from];
+    if(!lod_pyramid_append(lod, batch, n)) return false;
+    from += n;
+  }
+  return true;
+}
+
+/* Saves pyramid to temporary file and loads it back into lod (old one is freed). */
+static bool lod_reload(s_lodPyramid *lod){
+  FILE *fp = tmpfile();
+  bool ok;
+
+  if(fp == NULL) return false;
+  ok = lod_pyramid_save(lod, fp);
+  lod_pyramid_free(lod);
+  rewind(fp);
+  ok = ok && lod_pyramid_load(lod, fp);
+  fclose(fp);
+  return ok;
+}
+
+/* Pyramid saved and loaded at any length (also shorter than one bucket) and appended to renders
+ * exactly as pyramid built in one go; aligned pixels match raw samples; full scale bucket of 2^17
+ * samples, whose sum does not fit 32 bits, keeps its mean. */
+static bool lod_pyramid_check(void){
+  static int16_t channel[EEG_CHANNELS][LOD_SAMPLES];
+  static int16_t full[1u << 17];
+  static s_lodPoint ref[LOD_PIXELS], out[LOD_PIXELS];
+  const size_t reload_at[] = {10, 1000, 4099, LOD_SAMPLES};
+  s_lodPyramid whole, lod;
+  uint32_t rng = 7;
+  size_t done = 0;
+  bool ok = true;
+
+  for(size_t n=0; n<LOD_SAMPLES; ++n)
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      channel[ch][n] = (int16_t)(test_random(&rng)%2001) - 1000;
+  if(!lod_pyramid_init(&whole, LOD_BASE) || !lod_pyramid_init(&lod, LOD_BASE)) return false;
+  ok = lod_append_range(&whole, channel, 0, LOD_SAMPLES);
+
+  for(size_t r=0; ok && r<sizeof(reload_at)/sizeof(reload_at[0]); ++r){
+    ok = lod_append_range(&lod, channel, done, reload_at[r]) && lod_reload(&lod) &&
+        lod.samples == reload_at[r];
+    done = reload_at[r];
+  }
+
+  for(uint8_t ch=0; ok && ch<EEG_CHANNELS; ++ch){
+    const uint64_t windows[][2] = {{0, LOD_SAMPLES}, {LOD_BASE, 4097},
+        {LOD_SAMPLES - 100, LOD_SAMPLES + 100}, {0, 4*LOD_BASE*LOD_PIXELS}};
+
+    for(size_t w=0; ok && w<sizeof(windows)/sizeof(windows[0]); ++w){
+      size_t p = lod_pyramid_render(&whole, ch, windows[w][0], windows[w][1], LOD_PIXELS, ref);
+      ok = lod_pyramid_render(&lod, ch, windows[w][0], windows[w][1], LOD_PIXELS, out) == p &&
+          memcmp(ref, out, p*sizeof(s_lodPoint)) == 0;
+    }
+    /* last window: aligned pixels of 4 buckets are exact min/max of raw samples */
+    for(size_t p=0; ok && p<LOD_PIXELS; ++p){
+      int16_t lo = INT16_MAX, hi = INT16_MIN;
+      double sum = 0;
+
+      for(size_t n=p*4*LOD_BASE; n<(p + 1)*4*LOD_BASE; ++n){
+        lo = channel[ch][n] < lo ? channel[ch][n] : lo;
+        hi = channel[ch][n] > hi ? channel[ch][n] : hi;
+        sum += channel[ch][n];
+      }
+      ok = ref[p].min == lo && ref[p].max == hi && fabs(ref[p].mean - sum/(4*LOD_BASE)) < 1e-3;
+    }
+  }
+  lod_pyramid_free(&whole);
+  lod_pyramid_free(&lod);
+
+  if(ok){
+    const int16_t *batch[EEG_CHANNELS];
+
+    for(size_t n=0; n<sizeof(full)/sizeof(full[0]); ++n) full[n] = INT16_MAX;
+    for(int ch=0; ch<EEG_CHANNELS; ++ch) batch[ch] = full;
+    ok = lod_pyramid_init(&lod, sizeof(full)/sizeof(full[0])) &&
+        lod_pyramid_append(&lod, batch, sizeof(full)/sizeof(full[0])) &&
+        lod_pyramid_render(&lod, 0, 0, sizeof(full)/sizeof(full[0]), 1, out) == 1 &&
+        out[0].mean == INT16_MAX;
+    lod_pyramid_free(&lod);
+  }
+  return ok;
+}
+
+/* Polyphase output does not depend on batch split and matches direct convolution of zero-stuffed
+ * input with the prototype filter; integer decimation up to 10 fits with default spec. */
+static bool decimator_check(void){
+  static float x[EEG_CHANNELS][DECIM_SAMPLES];
+  static float y[2][EEG_CHANNELS][2*DECIM_SAMPLES];
+  static s_decimator dec;
+  static s_decimatorState state;
+  const uint8_t factors[][2] = {{2, 5}, {1, 8}, {3, 2}};
+  s_decimatorSpec spec;
+  uint32_t rng = 11;
+
+  decimator_default_spec(&spec, 1, 10);
+  if(!decimator_design(&dec, &spec)) return false;
+  decimator_default_spec(&spec, 1, 11);
+  if(decimator_design(&dec, &spec)) return false;
+
+  for(size_t n=0; n<DECIM_SAMPLES; ++n)
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      x[ch][n] = (float)(test_random(&rng)%20001)/100 - 100;
+
+  for(size_t f=0; f<sizeof(factors)/sizeof(factors[0]); ++f){
+    const uint8_t up = factors[f][0], down = factors[f][1];
+    size_t outputs[2] = {0, 0};
+
+    decimator_default_spec(&spec, up, down);
+    if(!decimator_design(&dec, &spec)) return false;
+    for(int split=0; split<2; ++split){
+      size_t n = 0;
+
+      decimator_reset(&state);
+      while(n < DECIM_SAMPLES){
+        size_t m = split ? test_random(&rng)%23 : DECIM_SAMPLES;
+        const float *in[EEG_CHANNELS];
+        float *out[EEG_CHANNELS];
+
+        m = m < DECIM_SAMPLES - n ? m : DECIM_SAMPLES - n;
+        for(int ch=0; ch<EEG_CHANNELS; ++ch){
+          in[ch] = &x[ch][n];
+          out[ch] = &y[split][ch][outputs[split]];
+        }
+        outputs[split] += decimator_process(&dec, &state, in, m, out);
+        n += m;
+      }
+    }
+    if(outputs[0] != outputs[1] || outputs[0] != (size_t)(DECIM_SAMPLES*up + down - 1)/down ||
+        memcmp(y[0], y[1], sizeof(y[0])) != 0)
+      return false;
+
+    /* prototype tap i is coef[(i%up)*taps + taps-1-i/up], output k is at interpolated k*down */
+    for(int ch=0; ch<EEG_CHANNELS; ++ch)
+      for(size_t k=0; k<outputs[0]; ++k){
+        double ref = 0;
+
+        for(size_t i=0; i<(size_t)up*dec.taps && i<=k*down; ++i)
+          if((k*down - i)%up == 0)
+            ref += (double)dec.coef[(i%up)*dec.taps + dec.taps - 1 - i/up]*x[ch][(k*down - i)/up];
+        if(fabs(y[0][ch][k] - ref) > 1e-3) return false;
+      }
+
+    /* unity DC gain of every phase */
+    for(uint8_t p=0; p<up; ++p){
+      double sum = 0;
+      for(uint8_t j=0; j<dec.taps; ++j) sum += dec.coef[p*dec.taps + j];
+      if(fabs(sum - 1) > 1e-3) return false;
+    }
+  }
+  return true;
+}
+
+/* Hann-windowed 12.5 Hz spindles are found on their channel only, the next one not sooner than
+ * refractory period after the end of previous one; a lasting step of sigma activity (background
+ * x8) does not block the channel, spindle on top of the new level is found. */
+static bool sleep_events_check(void){
+  static float x[EEG_CHANNELS][EVENT_SAMPLES];
+  static s_sleepEventPlan plan;
+  static s_sleepEventState state;
+  static s_sleepEvent event[EVENT_MAX];
+  /* second spindle of channel 2 starts within refractory period of the first one */
+  const float spindle_at[] = {20, 35, 50, 80, 81.6f, 200};
+  const float late[] = {0.4f, 0.4f, 0.4f, 0.4f, 0.9f, 0.4f};
+  const uint8_t spindle_ch[] = {0, 0, 0, 2, 2, 1};
+  const size_t spindles = sizeof(spindle_at)/sizeof(spindle_at[0]);
+  uint64_t end[EEG_CHANNELS] = {0};
+  s_sleepEventSpec spec;
+  size_t events = 0, found = 0, n = 0;
+  uint32_t rng = 13;
+
+  for(size_t i=0; i<EVENT_SAMPLES; ++i)
+    for(int ch=0; ch<EEG_CHANNELS; ++ch){
+      x[ch][i] = (float)(test_random(&rng)%2001)/100 - 10;
+      if(ch == 1 && i >= 30*EVENT_RATE) x[ch][i] *= 8;
+    }
+  for(size_t s=0; s<spindles; ++s){
+    float amplitude = spindle_ch[s] == 1 ? 240 : 30;
+    for(size_t i=0; i<EVENT_RATE; ++i)
+      x[spindle_ch[s]][(size_t)(spindle_at[s]*EVENT_RATE) + i] += amplitude*
+          (float)(0.5 - 0.5*cos(2*M_PI*i/EVENT_RATE))*(float)sin(2*M_PI*12.5*i/EVENT_RATE);
+  }
+
+  sleep_events_default_spec(&spec, EVENT_RATE);
+  if(!sleep_events_plan(&plan, &spec)) return false;
+  sleep_events_reset(&state);
+  while(n < EVENT_SAMPLES){
+    size_t m = 1 + test_random(&rng)%400;
+    const float *in[EEG_CHANNELS];
+
+    m = m < EVENT_SAMPLES - n ? m : EVENT_SAMPLES - n;
+    for(int ch=0; ch<EEG_CHANNELS; ++ch) in[ch] = &x[ch][n];
+    events += sleep_events_process(&plan, &state, in, m, &event[events], EVENT_MAX - events);
+    n += m;
+  }
+
+  for(size_t e=0; e<events; ++e){
+    double start = (double)event[e].start/EVENT_RATE;
+    uint8_t ch = event[e].channel;
+
+    if(event[e].type != SLEEP_EVENT_SPINDLE) continue;
+    if(found == spindles || ch != spindle_ch[found] || start < spindle_at[found] ||
+        start > spindle_at[found] + late[found] || event[e].duration < 0.5f ||
+        event[e].duration > 2.0f || event[e].frequency < 11.5f || event[e].frequency > 14.0f)
+      return false;
+    /* default refractory period is 1 s */
+    if(end[ch] && event[e].start < end[ch] + EVENT_RATE) return false;
+    end[ch] = event[e].start + (uint64_t)(event[e].duration*EVENT_RATE + 0.5f);
+    ++found;
+  }
+  return found == spindles && state.dropped == 0;
+}
+
+/* Pulse passes unchanged while the head is still; artifact made of filtered accelerometer motion
+ * (random, below 3 Hz) is cancelled once filter has adapted; in-place batches give the same output
+ * as one call. */
+static bool ppg_artifact_check(void){
+  static int32_t ir[PPG_SAMPLES], red[PPG_SAMPLES], clean[2][PPG_SAMPLES];
+  static int32_t ir_out[PPG_SAMPLES], red_out[PPG_SAMPLES];
+  static int16_t acc[3][PPG_SAMPLES];
+  static double artifact[PPG_SAMPLES];
+  const double mg_per_lsb = 4000.0/65536.0;
+  s_ppgArtifactConfig config;
+  s_ppgArtifactState state;
+  double still[2] = {0, 0}, moving[3] = {0, 0, 0}, mx = 0, my = 0;
+  uint32_t rng = 17;
+
+  for(size_t n=0; n<PPG_SAMPLES; ++n){
+    double t = (double)n/PPG_RATE, phase = fmod(t*1.2, 1.0);
+    double pulse = phase < 0.15 ? sin(M_PI/2*phase/0.15) : exp(-(phase - 0.15)*4);
+    /* head moves from PPG_STILL on: low-passed noise of about 250 mg RMS [mg] */
+    double move = n < PPG_STILL*PPG_RATE ? 0 : 1.5;
+
+    mx += (move*((double)(test_random(&rng)%2001) - 1000) - mx)*0.15;
+    my += (move*((double)(test_random(&rng)%2001) - 1000) - my)*0.15;
+
+    acc[0][n] = (int16_t)lrint(mx/mg_per_lsb);
+    acc[1][n] = (int16_t)lrint(my/mg_per_lsb);
+    acc[2][n] = (int16_t)(lrint(1000/mg_per_lsb) + (test_random(&rng)%3) - 1);
+    clean[0][n] = (int32_t)(100000 - 1000*pulse);
+    clean[1][n] = (int32_t)(80000 - 480*pulse);
+  }
+  for(size_t n=0; n<PPG_SAMPLES; ++n){
+    /* light path changes with acceleration and (3 samples later) with tilt */
+    artifact[n] = 2*acc[0][n]*mg_per_lsb - (n >= 3 ? 1.5*acc[1][n-3]*mg_per_lsb : 0);
+    ir[n] = clean[0][n] + (int32_t)lrint(artifact[n]);
+    red[n] = clean[1][n] + (int32_t)lrint(0.5*artifact[n]);
+  }
+
+  ppg_artifact_default_config(&config, PPG_RATE);
+  if(!ppg_artifact_init(&state, &config)) return false;
+  ppg_artifact_process(&state, ir, red, acc[0], acc[1], acc[2], PPG_SAMPLES, ir_out, red_out);
+
+  for(size_t n=PPG_RATE*PPG_STILL/2; n<PPG_SAMPLES; ++n){
+    double e = ir_out[n] - clean[0][n];
+
+    if(n < PPG_STILL*PPG_RATE){
+      still[0] += e*e;
+      still[1] += (clean[0][n] - 100000 + 500.0)*(clean[0][n] - 100000 + 500.0);
+    }
+    else if(n >= PPG_SAMPLES - 30*PPG_RATE){
+      moving[0] += e*e;
+      moving[1] += artifact[n]*artifact[n];
+      moving[2] += (red_out[n] - clean[1][n])*(double)(red_out[n] - clean[1][n]);
+    }
+  }
+  /* pulse kept within 3 %, artifact suppressed by 7 dB in both channels */
+  if(still[0] > 0.03*0.03*still[1] || moving[0] > 0.2*moving[1] ||
+      moving[2] > 0.2*0.25*moving[1])
+    return false;
+
+  /* in place, uneven batches */
+  ppg_artifact_init(&state, &config);
+  for(size_t n=0, batch=1; n<PPG_SAMPLES; n+=batch, batch=batch%53 + 1){
+    if(n + batch > PPG_SAMPLES) batch = PPG_SAMPLES - n;
+    ppg_artifact_process(&state, &ir[n], &red[n], &acc[0][n], &acc[1][n], &acc[2][n], batch,
+        &ir[n], &red[n]);
+  }
+  return memcmp(ir, ir_out, sizeof(ir)) == 0 && memcmp(red, red_out, sizeof(red)) == 0;
+}
+
+/* Periodic motion at pulse rate (1.2 Hz) or its second harmonic is notched together with the
+ * pulse: coherently averaged pulse keeps 55-70 % and 70-85 % of its peak to peak amplitude. */
+static bool ppg_harmonic_check(void){
+  static int32_t ir[PPG_SAMPLES], red[PPG_SAMPLES], clean[PPG_SAMPLES];
+  static int16_t acc[3][PPG_SAMPLES];
+  const double mg_per_lsb = 4000.0/65536.0;
+  const double bound[2][2] = {{0.55, 0.7}, {0.7, 0.85}};
+  s_ppgArtifactConfig config;
+  s_ppgArtifactState state;
+
+  ppg_artifact_default_config(&config, PPG_RATE);
+  for(int h=0; h<2; ++h){
+    /* 5 s hold exactly 6 beats */
+    static double avg[2][5*PPG_RATE];
+    double lo[2] = {INFINITY, INFINITY}, hi[2] = {-INFINITY, -INFINITY}, ratio;
+
+    for(size_t n=0; n<PPG_SAMPLES; ++n){
+      double t = (double)n/PPG_RATE, phase = fmod(t*1.2, 1.0);
+      double pulse = phase < 0.15 ? sin(M_PI/2*phase/0.15) : exp(-(phase - 0.15)*4);
+
+      acc[0][n] = (int16_t)lrint(250*sin(2*M_PI*1.2*(h + 1)*t)/mg_per_lsb);
+      acc[1][n] = 0;
+      acc[2][n] = (int16_t)lrint(1000/mg_per_lsb);
+      clean[n] = (int32_t)(100000 - 1000*pulse);
+      ir[n] = clean[n] + (int32_t)lrint(2*acc[0][n]*mg_per_lsb);
+      red[n] = ir[n];
+    }
+    if(!ppg_artifact_init(&state, &config)) return false;
+    ppg_artifact_process(&state, ir, red, acc[0], acc[1], acc[2], PPG_SAMPLES, ir, red);
+
+    memset(avg, 0, sizeof(avg));
+    for(size_t n=PPG_SAMPLES - 30*PPG_RATE; n<PPG_SAMPLES; ++n){
+      avg[0][n%(5*PPG_RATE)] += ir[n];
+      avg[1][n%(5*PPG_RATE)] += clean[n];
+    }
+    for(int i=0; i<2; ++i)
+      for(size_t k=0; k<5*PPG_RATE; ++k){
+        lo[i] = avg[i][k] < lo[i] ? avg[i][k] : lo[i];
+        hi[i] = avg[i][k] > hi[i] ? avg[i][k] : hi[i];
+      }
+    ratio = (hi[0] - lo[0])/(hi[1] - lo[1]);
+    if(ratio < bound[h][0] || ratio > bound[h][1]) return false;
+  }
+  return true;
+}
+
+static int float_compare(const void *a, const void *b){
+  float fa = *(const float *)a, fb = *(const float *)b;
+  return (fa > fb) - (fa < fb);
+}
+
+/* Sketches of uneven (also empty) parts merged in order and as a tree equal sketch of all values:
+ * moments to rounding, histogram exactly, quantiles within rank error of the digest; NaNs are
+ * skipped. */
+static bool sketch_check(void){
+  static float value[SKETCH_VALUES], sorted[SKETCH_VALUES];
+  static s_sketchQuantiles q_whole, q_part[SKETCH_PARTS], q_chain;
+  const size_t cut[SKETCH_PARTS + 1] = {0, 1, 300, 2600, 2600, 9000, 15000, SKETCH_VALUES};
+  const float quantile[] = {0.001f, 0.01f, 0.1f, 0.25f, 0.5f, 0.75f, 0.9f, 0.99f, 0.999f};
+  s_sketchMoments m_whole, m_part[SKETCH_PARTS], m_chain;
+  s_sketchHistogram h_whole, h_part[SKETCH_PARTS], h_chain, h_other;
+  size_t valid = 0;
+  uint32_t rng = 19;
+
+  /* SpO2-like values, skewed to low side, every 97th one missing */
+  for(size_t n=0; n<SKETCH_VALUES; ++n){
+    double u = (test_random(&rng)%100000 + 0.5)/100000;
+    value[n] = n%97 == 13 ? NAN : (float)(98 - 4*pow(-log(u), 1.5));
+    if(!isnan(value[n])) sorted[valid++] = value[n];
+  }
+  qsort(sorted, valid, sizeof(float), float_compare);
+
+  sketch_moments_reset(&m_whole);
+  sketch_quantiles_reset(&q_whole);
+  sketch_histogram_init(&h_whole, 80, 100);
+  sketch_moments_add(&m_whole, value, SKETCH_VALUES);
+  sketch_quantiles_add(&q_whole, value, SKETCH_VALUES);
+  sketch_histogram_add(&h_whole, value, SKETCH_VALUES);
+  for(int p=0; p<SKETCH_PARTS; ++p){
+    sketch_moments_reset(&m_part[p]);
+    sketch_quantiles_reset(&q_part[p]);
+    sketch_histogram_init(&h_part[p], 80, 100);
+    sketch_moments_add(&m_part[p], &value[cut[p]], cut[p+1] - cut[p]);
+    sketch_quantiles_add(&q_part[p], &value[cut[p]], cut[p+1] - cut[p]);
+    sketch_histogram_add(&h_part[p], &value[cut[p]], cut[p+1] - cut[p]);
+  }
+
+  /* in order into empty sketches */
+  sketch_moments_reset(&m_chain);
+  sketch_quantiles_reset(&q_chain);
+  sketch_histogram_init(&h_chain, 80, 100);
+  for(int p=0; p<SKETCH_PARTS; ++p){
+    sketch_moments_merge(&m_chain, &m_part[p]);
+    sketch_quantiles_merge(&q_chain, &q_part[p]);
+    if(!sketch_histogram_merge(&h_chain, &h_part[p])) return false;
+  }
+  /* as a tree, parts are merged into part 0 */
+  for(int step=1; step<SKETCH_PARTS; step*=2)
+    for(int p=0; p+step<SKETCH_PARTS; p+=2*step){
+      sketch_moments_merge(&m_part[p], &m_part[p+step]);
+      sketch_quantiles_merge(&q_part[p], &q_part[p+step]);
+      sketch_histogram_merge(&h_part[p], &h_part[p+step]);
+    }
+
+  sketch_histogram_init(&h_other, 80, 101);
+  if(sketch_histogram_merge(&h_chain, &h_other)) return false;
+  if(m_whole.count != valid || memcmp(&h_whole, &h_chain, sizeof(h_whole)) != 0 ||
+      memcmp(&h_whole, &h_part[0], sizeof(h_whole)) != 0)
+    return false;
+  for(int s=0; s<3; ++s){
+    const s_sketchMoments *m = s == 0 ? &m_chain : (s == 1 ? &m_part[0] : &m_whole);
+    s_sketchQuantiles *q = s == 0 ? &q_chain : (s == 1 ? &q_part[0] : &q_whole);
+
+    if(m->count != m_whole.count || m->min != m_whole.min || m->max != m_whole.max ||
+        fabs(m->mean - m_whole.mean) > 1e-9*fabs(m_whole.mean) ||
+        fabs(sketch_moments_variance(m) - sketch_moments_variance(&m_whole)) >
+        1e-9*sketch_moments_variance(&m_whole))
+      return false;
+    if(sketch_quantiles_get(q, 0) != sorted[0] || sketch_quantiles_get(q, 1) != sorted[valid-1])
+      return false;
+    /* rank error of the digest grows towards the middle (scale function) */
+    for(size_t i=0; i<sizeof(quantile)/sizeof(quantile[0]); ++i){
+      float estimate = sketch_quantiles_get(q, quantile[i]);
+      size_t lo = 0, hi = valid;
+
+      while(lo < hi){
+        size_t mid = (lo + hi)/2;
+        if(sorted[mid] < estimate) lo = mid + 1;
+        else hi = mid;
+      }
+      if(fabs((double)lo/valid - quantile[i]) >
+          0.001 + 2.0*quantile[i]*(1 - quantile[i])/SKETCH_COMPRESSION)
+        return false;
+    }
+  }
+  return true;
+}
+
+/* Every characteristic of nuc_init has its own routing slot, in both byte orders and as 16 bit
+ * UUID; unknown UUIDs, bad lengths and RX characteristics are not routed. */
+static bool characteristics_check(void){
+  char chars[NO_CHARECTERISTICS][UUID_LENGTH+1];
+  uint8_t be[UUID_BINARY_LENGTH], le[UUID_BINARY_LENGTH], uuid16[2];
+  char rsp[NUC_FRAME_SIZE];
+  size_t len = sizeof(rsp);
+  uint8_t data[NUC_FRAME_SIZE] = {0};
+  size_t routed = 0;
+  bool rx;
+
+  nuc_init(chars);
+  status_rsp_gen_func(rsp, &len, (s_devsFunc){0}, 0, 1);
+  for(size_t i=0; i<NO_CHARECTERISTICS; ++i){
+    for(size_t j=0, k=0; k<UUID_BINARY_LENGTH; ++j){
+      if(chars[i][j] == '-') continue;
+      be[k++] = (uint8_t)strtoul((char[]){chars[i][j], chars[i][j+1], 0}, NULL, 16);
+      ++j;
+    }
+    for(size_t k=0; k<UUID_BINARY_LENGTH; ++k) le[k] = be[UUID_BINARY_LENGTH-1-k];
+    if(nuc_characteristic_from_uuid128(be, false) != i ||
+        nuc_characteristic_from_uuid128(le, true) != i ||
+        nuc_characteristic_from_uuid16((uint16_t)(be[2]<<8 | be[3])) != i)
+      return false;
+
+    rx = i == CMD_UUID || i == SETTINGS_RX_UUID || i == DFU_RX_UUID;
+    if((nuc_notification_route(be, sizeof(be), false, (uint8_t *)rsp, sizeof(rsp)) ==
+          ERROR_UUID) != rx)
+      return false;
+    uuid16[0] = be[3];
+    uuid16[1] = be[2];
+    if((nuc_notification_route(uuid16, sizeof(uuid16), true, (uint8_t *)rsp, sizeof(rsp)) ==
+          ERROR_UUID) != rx)
+      return false;
+    if(nuc_notification_route(be, 4, false, (uint8_t *)rsp, sizeof(rsp)) != ERROR_UUID)
+      return false;
+
+    /* other service base */
+    be[5] ^= 0x01;
+    if(nuc_characteristic_from_uuid128(be, false) != ERROR_UUID) return false;
+  }
+
+  uuid16[0] = 0x02;
+  uuid16[1] = 0x03;
+  if(nuc_notification_route(uuid16, sizeof(uuid16), false, data, sizeof(data)) != ERROR_UUID)
+    return false;
+  /* only the nine characteristic UUIDs are routed */
+  for(uint32_t uuid=0; uuid<=0xFFFF; ++uuid)
+    routed += nuc_characteristic_from_uuid16((uint16_t)uuid) != ERROR_UUID;
+  return routed == NO_CHARECTERISTICS;
+}
+
 int main(void){
   char array[ARRAY_SIZE];
   size_t len = sizeof(array);
@@ -53,6 +1523,35 @@ int main(void){
   printf("minor:\t\t%d\n",nuc_get_version_minor());
   printf("patch:\t\t%d\n",nuc_get_version_patch());
 
+  RUN_CHECK(stream_decoder_check, "stream decoder");
+  RUN_CHECK(eeg_uv_check, "eeg microvolts");
+  RUN_CHECK(dev_response_check, "device response");
+  RUN_CHECK(timer_wheel_check, "timer wheel");
+  RUN_CHECK(alarm_scheduler_check, "alarm scheduler");
+  RUN_CHECK(pox_shadow_check, "pox shadow");
+  RUN_CHECK(status_store_check, "status store");
+  RUN_CHECK(restore_check, "restore");
+  RUN_CHECK(async_check, "async loop");
+  RUN_CHECK(mask_emulator_check, "mask emulator");
+  RUN_CHECK(characteristics_check, "characteristics");
+  RUN_CHECK(stream_tracker_check, "stream tracker");
+  RUN_CHECK(clock_sync_check, "clock sync");
+  RUN_CHECK(stream_merge_check, "stream merge");
+  RUN_CHECK(eeg_filter_check, "eeg filter");
+  RUN_CHECK(band_power_check, "band power");
+  RUN_CHECK(spo2_check, "spo2");
+  RUN_CHECK(eeg_quality_check, "eeg quality");
+  RUN_CHECK(actigraphy_check, "actigraphy");
+  RUN_CHECK(sleep_stage_check, "sleep stage");
+  RUN_CHECK(stimulation_check, "stimulation");
+  RUN_CHECK(ring_cache_check, "ring cache");
+  RUN_CHECK(lod_pyramid_check, "lod pyramid");
+  RUN_CHECK(decimator_check, "decimator");
+  RUN_CHECK(sleep_events_check, "sleep events");
+  RUN_CHECK(ppg_artifact_check, "ppg artifact");
+  RUN_CHECK(ppg_harmonic_check, "ppg harmonic motion");
+  RUN_CHECK(sketch_check, "sketch");
+
 
   return 0l;
 }
@@ -0,0 +1,69 @@
+/**
+ * @file    test_coro.cpp
+ * @Author  Paweł Kaźmierzewski <p.kazmierzewski@inteliclinic.com>
+ * @date    October, 2026
+ * @brief   C++20 coroutine interface checks
+ *
+ * Built only with NUC_CORO_TEST option.
+ */
+
+#include <cstdio>
+#include "ic_async_coro.hpp"
+#include "ic_low_level_control.h"
+
+#define RUN_CHECK(check, name)do{\
+  if(!check()){\
+    std::printf(name ": FAILED\n");\
+    return -1;}\
+  std::printf(name ": OK\n");\
+}while(0)
+
+static s_asyncLoop loop;
+static s_asyncLoopback lb;
+static nuc::response rsp[2];
+static int finished;
+
+static nuc::task exchange(uint16_t id, uint32_t timeout_ms, nuc::response *out){
+  char frame[NUC_FRAME_SIZE];
+  size_t len = sizeof(frame);
+  int uuid = vibrator_ON(frame, &len, id);
+
+  *out = co_await nuc::send(&loop, &lb.transport, frame, uuid, timeout_ms);
+  ++finished;
+}
+
+/* Coroutine suspended on command resumes from the loop with loopback response. */
+static bool coro_exchange_check(){
+  async_loop_init(&loop, 0);
+  async_loopback_init(&lb);
+  async_loop_attach(&loop, &lb.transport);
+  finished = 0;
+
+  exchange(1, 100, &rsp[0]);
+  if(finished != 0 || async_loop_pending(&loop) != 1) return false;
+  async_loop_run_once(&loop, 10);
+  return finished == 1 && rsp[0].sent && rsp[0].result == ASYNC_OK &&
+      async_loop_pending(&loop) == 0;
+}
+
+/* Coroutine waiting on muted transport resumes with timeout, not earlier. */
+static bool coro_timeout_check(){
+  async_loop_init(&loop, 0);
+  async_loopback_init(&lb);
+  async_loop_attach(&loop, &lb.transport);
+  lb.mute = true;
+  finished = 0;
+
+  exchange(2, 100, &rsp[1]);
+  async_loop_run_once(&loop, 99);
+  if(finished != 0) return false;
+  async_loop_run_once(&loop, 100);
+  return finished == 1 && rsp[1].sent && rsp[1].result == ASYNC_TIMEOUT &&
+      async_loop_pending(&loop) == 0;
+}
+
+int main(){
+  RUN_CHECK(coro_exchange_check, "coroutine exchange");
+  RUN_CHECK(coro_timeout_check, "coroutine timeout");
+  return 0;
+}